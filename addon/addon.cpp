@@ -1,6 +1,8 @@
 #include <tuple>
 #include <ranges>
+#include <expected>
 #include <optional>
+#include <functional>
 
 #include <napi.h>
 #include <vencord/patchbay.hpp>
@@ -32,6 +34,17 @@ namespace
         return value.ToBoolean();
     }
 
+    template <>
+    std::optional<std::uint32_t> convert(Napi::Value value)
+    {
+        if (!value.IsNumber())
+        {
+            return std::nullopt;
+        }
+
+        return value.ToNumber().Uint32Value();
+    }
+
     template <>
     std::optional<vencord::node> convert(Napi::Value value)
     {
@@ -87,6 +100,231 @@ namespace
         return rtn;
     }
 
+    std::optional<std::vector<std::string>> props_of(const Napi::CallbackInfo &info)
+    {
+        if (info.Length() != 1 || info[0].IsUndefined())
+        {
+            return std::vector<std::string>{};
+        }
+
+        return to_array<std::string>(info[0]);
+    }
+
+    Napi::Array from_nodes(Napi::Env env, const std::vector<vencord::node> &nodes)
+    {
+        auto rtn = Napi::Array::New(env, nodes.size());
+
+        const auto convert = [&](const auto &item)
+        {
+            auto rtn = Napi::Object::New(env);
+
+            for (const auto &[key, value] : item)
+            {
+                rtn.Set(key, Napi::String::New(env, value));
+            }
+
+            return rtn;
+        };
+
+        const auto add = [&](const auto &item)
+        {
+            rtn.Set(std::get<0>(item), std::get<1>(item));
+        };
+
+        std::ranges::for_each(nodes                                //
+                                  | std::views::transform(convert) //
+                                  | std::views::enumerate,
+                              add);
+
+        return rtn;
+    }
+
+    std::expected<vencord::link_options, std::string> options_of(const Napi::CallbackInfo &info)
+    {
+        if (info.Length() != 1 || !info[0].IsObject())
+        {
+            return std::unexpected{"[venmic] expected link object"};
+        }
+
+        const auto data = info[0].ToObject();
+
+        if (!data.Has("include") && !data.Has("exclude"))
+        {
+            return std::unexpected{"[venmic] expected at least one of keys 'include' or 'exclude'"};
+        }
+
+        const auto include               = to_array<vencord::node>(data.Get("include"));
+        const auto exclude               = to_array<vencord::node>(data.Get("exclude"));
+        const auto ignore_devices        = convert<bool>(data.Get("ignore_devices"));
+        const auto mute                  = convert<bool>(data.Get("mute"));
+        const auto only_speakers         = convert<bool>(data.Get("only_speakers"));
+        const auto only_default_speakers = convert<bool>(data.Get("only_default_speakers"));
+        const auto workaround            = to_array<vencord::node>(data.Get("workaround"));
+        const auto direct                = convert<bool>(data.Get("direct"));
+        const auto mixer                 = convert<bool>(data.Get("mixer"));
+        const auto meter                 = convert<bool>(data.Get("meter"));
+        const auto duplex                = convert<bool>(data.Get("duplex"));
+        const auto positions             = to_array<std::string>(data.Get("positions"));
+        const auto rate                  = convert<std::uint32_t>(data.Get("rate"));
+        const auto latency               = convert<std::uint32_t>(data.Get("latency"));
+        const auto force_quantum         = convert<bool>(data.Get("force_quantum"));
+        const auto gate                  = convert<std::uint32_t>(data.Get("gate"));
+
+        if (!include.has_value() && !exclude.has_value())
+        {
+            return std::unexpected{"[venmic] expected either 'include' or 'exclude' or both to be present and to be "
+                                   "arrays of key-value pairs"};
+        }
+
+        return vencord::link_options{
+            .include               = include.value_or(std::vector<vencord::node>{}),
+            .exclude               = exclude.value_or(std::vector<vencord::node>{}),
+            .mute                  = mute.value_or(false),
+            .ignore_devices        = ignore_devices.value_or(true),
+            .only_speakers         = only_speakers.value_or(true),
+            .only_default_speakers = only_default_speakers.value_or(true),
+            .workaround            = workaround.value_or(std::vector<vencord::node>{}),
+            .direct                = direct.value_or(false),
+            .mixer                 = mixer.value_or(false),
+            .meter                 = meter.value_or(false),
+            .duplex                = duplex.value_or(false),
+            .positions             = positions.value_or(std::vector<std::string>{"FL", "FR"}),
+            .rate                  = rate.value_or(0),
+            .latency               = latency.value_or(0),
+            .force_quantum         = force_quantum.value_or(false),
+            .gate                  = gate.value_or(0),
+        };
+    }
+
+    Napi::Array from_latencies(Napi::Env env, const std::vector<vencord::latency> &latencies)
+    {
+        auto rtn = Napi::Array::New(env, latencies.size());
+
+        const auto range = [&](const auto &values)
+        {
+            auto rtn = Napi::Array::New(env, values.size());
+
+            for (auto i = 0uz; values.size() > i; ++i)
+            {
+                rtn.Set(i, Napi::Number::New(env, static_cast<double>(values[i])));
+            }
+
+            return rtn;
+        };
+
+        const auto convert = [&](const auto &item)
+        {
+            auto rtn = Napi::Object::New(env);
+
+            rtn.Set("node", Napi::Number::New(env, item.node));
+            rtn.Set("quantum", range(item.quantum));
+            rtn.Set("rate", range(item.rate));
+            rtn.Set("ns", range(item.ns));
+            rtn.Set("total", Napi::Number::New(env, static_cast<double>(item.total)));
+
+            return rtn;
+        };
+
+        const auto add = [&](const auto &item)
+        {
+            rtn.Set(std::get<0>(item), std::get<1>(item));
+        };
+
+        std::ranges::for_each(latencies                            //
+                                  | std::views::transform(convert) //
+                                  | std::views::enumerate,
+                              add);
+
+        return rtn;
+    }
+
+    Napi::Array from_loads(Napi::Env env, const std::vector<vencord::load> &loads)
+    {
+        auto rtn = Napi::Array::New(env, loads.size());
+
+        const auto convert = [&](const auto &item)
+        {
+            auto rtn = Napi::Object::New(env);
+
+            rtn.Set("node", Napi::Number::New(env, item.node));
+            rtn.Set("name", Napi::String::New(env, item.name));
+            rtn.Set("xruns", Napi::Number::New(env, static_cast<double>(item.xruns)));
+            rtn.Set("cycles", Napi::Number::New(env, item.cycles));
+            rtn.Set("busy", Napi::Number::New(env, item.busy));
+            rtn.Set("wait", Napi::Number::New(env, item.wait));
+            rtn.Set("peak", Napi::Number::New(env, item.peak));
+
+            return rtn;
+        };
+
+        const auto add = [&](const auto &item)
+        {
+            rtn.Set(std::get<0>(item), std::get<1>(item));
+        };
+
+        std::ranges::for_each(loads                                //
+                                  | std::views::transform(convert) //
+                                  | std::views::enumerate,
+                              add);
+
+        return rtn;
+    }
+
+    // Runs a query on the libuv thread-pool, so that the javascript thread never waits on the pipewire thread
+    template <typename T>
+    struct query_worker : public Napi::AsyncWorker
+    {
+        using query_t   = std::function<T()>;
+        using convert_t = Napi::Array (*)(Napi::Env, const T &);
+
+      private:
+        Napi::Promise::Deferred deferred;
+        query_t query;
+        convert_t convert;
+        T result;
+
+      private:
+        query_worker(Napi::Env env, query_t query, convert_t convert)
+            : Napi::AsyncWorker(env), deferred(Napi::Promise::Deferred::New(env)), query(std::move(query)),
+              convert(convert)
+        {
+        }
+
+      public:
+        void Execute() override
+        {
+            try
+            {
+                result = query();
+            }
+            catch (std::exception &e)
+            {
+                SetError(e.what());
+            }
+        }
+
+        void OnOK() override
+        {
+            deferred.Resolve(convert(Env(), result));
+        }
+
+        void OnError(const Napi::Error &error) override
+        {
+            deferred.Reject(error.Value());
+        }
+
+      public:
+        static Napi::Promise queue(Napi::Env env, query_t query, convert_t convert)
+        {
+            auto *const worker = new query_worker{env, std::move(query), convert}; // Deletes itself once completed
+            auto rtn           = worker->deferred.Promise();
+
+            worker->Queue();
+
+            return rtn;
+        }
+    };
+
     struct patchbay : public Napi::ObjectWrap<patchbay>
     {
         patchbay(const Napi::CallbackInfo &info) : Napi::ObjectWrap<patchbay>::ObjectWrap(info)
@@ -103,44 +341,107 @@ namespace
 
       public:
         Napi::Value list(const Napi::CallbackInfo &info) // NOLINT(*-static)
+        {
+            const auto env   = info.Env();
+            const auto props = props_of(info);
+
+            if (!props.has_value())
+            {
+                Napi::Error::New(env, "[venmic] expected list of strings").ThrowAsJavaScriptException();
+                return {};
+            }
+
+            return from_nodes(env, vencord::patchbay::get().list(*props));
+        }
+
+        Napi::Value list_async(const Napi::CallbackInfo &info) // NOLINT(*-static)
+        {
+            const auto env   = info.Env();
+            const auto props = props_of(info);
+
+            if (!props.has_value())
+            {
+                auto deferred = Napi::Promise::Deferred::New(env);
+                deferred.Reject(Napi::Error::New(env, "[venmic] expected list of strings").Value());
+
+                return deferred.Promise();
+            }
+
+            return query_worker<std::vector<vencord::node>>::queue(
+                env, [props = *props] { return vencord::patchbay::get().list(props); }, from_nodes);
+        }
+
+        Napi::Value link(const Napi::CallbackInfo &info) // NOLINT(*-static)
         {
             const auto env = info.Env();
-            auto props     = std::vector<std::string>{};
+            auto options   = options_of(info);
 
-            if (info.Length() == 1 && !info[0].IsUndefined())
+            if (!options.has_value())
             {
-                auto array = to_array<std::string>(info[0]);
+                Napi::Error::New(env, options.error()).ThrowAsJavaScriptException();
+                return Napi::Boolean::New(env, false);
+            }
 
-                if (!array.has_value())
-                {
-                    Napi::Error::New(env, "[venmic] expected list of strings").ThrowAsJavaScriptException();
-                    return {};
-                }
+            vencord::patchbay::get().link(std::move(*options));
+
+            return Napi::Boolean::New(env, true);
+        }
+
+        Napi::Value link_async(const Napi::CallbackInfo &info) // NOLINT(*-static)
+        {
+            const auto env = info.Env();
+            auto deferred  = Napi::Promise::Deferred::New(env);
+            auto options   = options_of(info);
 
-                props = std::move(*array);
+            if (!options.has_value())
+            {
+                deferred.Reject(Napi::Error::New(env, options.error()).Value());
+                return deferred.Promise();
             }
 
-            auto list = vencord::patchbay::get().list(props);
-            auto rtn  = Napi::Array::New(env, list.size());
+            // Linking only queues the request for the pipewire thread, so the promise resolves once it is queued
+            vencord::patchbay::get().link(std::move(*options));
+            deferred.Resolve(Napi::Boolean::New(env, true));
 
-            const auto convert = [&](const auto &item)
+            return deferred.Promise();
+        }
+
+        Napi::Value levels(const Napi::CallbackInfo &info) // NOLINT(*-static)
+        {
+            const auto env = info.Env();
+
+            auto levels = vencord::patchbay::get().levels();
+            auto rtn    = Napi::Array::New(env, levels.size());
+
+            const auto channels = [&](const auto &values)
             {
-                auto rtn = Napi::Object::New(env);
+                auto rtn = Napi::Array::New(env, values.size());
 
-                for (const auto &[key, value] : item)
+                for (auto i = 0uz; values.size() > i; ++i)
                 {
-                    rtn.Set(key, Napi::String::New(env, value));
+                    rtn.Set(i, Napi::Number::New(env, values[i]));
                 }
 
                 return rtn;
             };
 
+            const auto convert = [&](const auto &item)
+            {
+                auto rtn = Napi::Object::New(env);
+
+                rtn.Set("node", Napi::Number::New(env, item.node));
+                rtn.Set("peak", channels(item.peak));
+                rtn.Set("rms", channels(item.rms));
+
+                return rtn;
+            };
+
             const auto add = [&](const auto &item)
             {
                 rtn.Set(std::get<0>(item), std::get<1>(item));
             };
 
-            std::ranges::for_each(list                                 //
+            std::ranges::for_each(levels                               //
                                       | std::views::transform(convert) //
                                       | std::views::enumerate,
                                   add);
@@ -148,54 +449,26 @@ namespace
             return rtn;
         }
 
-        Napi::Value link(const Napi::CallbackInfo &info) // NOLINT(*-static)
+        Napi::Value measure(const Napi::CallbackInfo &info) // NOLINT(*-static)
         {
-            const auto env = info.Env();
-
-            if (info.Length() != 1 || !info[0].IsObject())
-            {
-                Napi::Error::New(env, "[venmic] expected link object").ThrowAsJavaScriptException();
-                return Napi::Boolean::New(env, false);
-            }
-
-            const auto data = info[0].ToObject();
-
-            if (!data.Has("include") && !data.Has("exclude"))
-            {
-                Napi::Error::New(env, "[venmic] expected at least one of keys 'include' or 'exclude'")
-                    .ThrowAsJavaScriptException();
-
-                return Napi::Boolean::New(env, false);
-            }
-
-            const auto include               = to_array<vencord::node>(data.Get("include"));
-            const auto exclude               = to_array<vencord::node>(data.Get("exclude"));
-            const auto ignore_devices        = convert<bool>(data.Get("ignore_devices"));
-            const auto mute                  = convert<bool>(data.Get("mute"));
-            const auto only_speakers         = convert<bool>(data.Get("only_speakers"));
-            const auto only_default_speakers = convert<bool>(data.Get("only_default_speakers"));
-            const auto workaround            = to_array<vencord::node>(data.Get("workaround"));
-
-            if (!include.has_value() && !exclude.has_value())
-            {
-                Napi::Error::New(env, "[venmic] expected either 'include' or 'exclude' or both to be present and to be "
-                                      "arrays of key-value pairs")
-                    .ThrowAsJavaScriptException();
+            return from_latencies(info.Env(), vencord::patchbay::get().measure());
+        }
 
-                return Napi::Boolean::New(env, false);
-            }
+        Napi::Value measure_async(const Napi::CallbackInfo &info) // NOLINT(*-static)
+        {
+            return query_worker<std::vector<vencord::latency>>::queue(
+                info.Env(), [] { return vencord::patchbay::get().measure(); }, from_latencies);
+        }
 
-            vencord::patchbay::get().link({
-                .include               = include.value_or(std::vector<vencord::node>{}),
-                .exclude               = exclude.value_or(std::vector<vencord::node>{}),
-                .mute                  = mute.value_or(false),
-                .ignore_devices        = ignore_devices.value_or(true),
-                .only_speakers         = only_speakers.value_or(true),
-                .only_default_speakers = only_default_speakers.value_or(true),
-                .workaround            = workaround.value_or(std::vector<vencord::node>{}),
-            });
+        Napi::Value telemetry(const Napi::CallbackInfo &info) // NOLINT(*-static)
+        {
+            return from_loads(info.Env(), vencord::patchbay::get().telemetry());
+        }
 
-            return Napi::Boolean::New(env, true);
+        Napi::Value telemetry_async(const Napi::CallbackInfo &info) // NOLINT(*-static)
+        {
+            return query_worker<std::vector<vencord::load>>::queue(
+                info.Env(), [] { return vencord::patchbay::get().telemetry(); }, from_loads);
         }
 
         Napi::Value unlink([[maybe_unused]] const Napi::CallbackInfo &) // NOLINT(*-static)
@@ -210,11 +483,47 @@ namespace
             return {};
         }
 
+        Napi::Value start_capture(const Napi::CallbackInfo &info) // NOLINT(*-static)
+        {
+            const auto env     = info.Env();
+            const auto seconds = info.Length() == 1 ? convert<std::uint32_t>(info[0]) : std::optional{30u};
+
+            if (!seconds.has_value())
+            {
+                Napi::Error::New(env, "[venmic] expected amount of seconds to capture").ThrowAsJavaScriptException();
+                return {};
+            }
+
+            vencord::patchbay::get().start_capture(*seconds);
+            return {};
+        }
+
+        Napi::Value stop_capture([[maybe_unused]] const Napi::CallbackInfo &) // NOLINT(*-static)
+        {
+            vencord::patchbay::get().stop_capture();
+            return {};
+        }
+
         static Napi::Value has_pipewire(const Napi::CallbackInfo &info)
         {
             return Napi::Boolean::New(info.Env(), vencord::patchbay::has_pipewire());
         }
 
+        static Napi::Value matches(const Napi::CallbackInfo &info)
+        {
+            const auto env   = info.Env();
+            const auto rules = info.Length() == 2 ? to_array<vencord::node>(info[0]) : std::nullopt;
+            const auto props = info.Length() == 2 ? convert<vencord::node>(info[1]) : std::nullopt;
+
+            if (!rules.has_value() || !props.has_value())
+            {
+                Napi::Error::New(env, "[venmic] expected list of rules and a node").ThrowAsJavaScriptException();
+                return {};
+            }
+
+            return Napi::Boolean::New(env, vencord::patchbay::matches(*rules, *props));
+        }
+
       public:
         static Napi::Object Init(Napi::Env env, Napi::Object exports)
         {
@@ -224,9 +533,19 @@ namespace
                                           {
                                               InstanceMethod<&patchbay::link>("link", attributes),
                                               InstanceMethod<&patchbay::list>("list", attributes),
+                                              InstanceMethod<&patchbay::list_async>("listAsync", attributes),
+                                              InstanceMethod<&patchbay::link_async>("linkAsync", attributes),
+                                              InstanceMethod<&patchbay::levels>("levels", attributes),
+                                              InstanceMethod<&patchbay::measure>("measure", attributes),
+                                              InstanceMethod<&patchbay::measure_async>("measureAsync", attributes),
+                                              InstanceMethod<&patchbay::telemetry>("telemetry", attributes),
+                                              InstanceMethod<&patchbay::telemetry_async>("telemetryAsync", attributes),
                                               InstanceMethod<&patchbay::unlink>("unlink", attributes),
                                               InstanceMethod<&patchbay::unmute>("unmute", attributes),
+                                              InstanceMethod<&patchbay::start_capture>("startCapture", attributes),
+                                              InstanceMethod<&patchbay::stop_capture>("stopCapture", attributes),
                                               StaticMethod<&patchbay::has_pipewire>("hasPipeWire", attributes),
+                                              StaticMethod<&patchbay::matches>("matches", attributes),
                                           });
 
             auto *const constructor = new Napi::FunctionReference{Napi::Persistent(func)};
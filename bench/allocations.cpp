@@ -0,0 +1,59 @@
+#include "bench.hpp"
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+#include <malloc.h>
+
+namespace
+{
+    std::atomic<std::size_t> count{0};
+    std::atomic<std::size_t> bytes{0};
+    std::atomic<std::size_t> live{0};
+} // namespace
+
+// Counts every allocation of the benchmark process, so that suites can report how much their subject allocates
+void *operator new(std::size_t size)
+{
+    auto *const rtn = std::malloc(size ? size : 1);
+
+    if (!rtn)
+    {
+        throw std::bad_alloc{};
+    }
+
+    count.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    live.fetch_add(malloc_usable_size(rtn), std::memory_order_relaxed);
+
+    return rtn;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    if (!pointer)
+    {
+        return;
+    }
+
+    live.fetch_sub(malloc_usable_size(pointer), std::memory_order_relaxed);
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+namespace bench
+{
+    allocations allocated()
+    {
+        return {
+            .count = count.load(std::memory_order_relaxed),
+            .bytes = bytes.load(std::memory_order_relaxed),
+            .live  = live.load(std::memory_order_relaxed),
+        };
+    }
+} // namespace bench
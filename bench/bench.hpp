@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace bench
+{
+    struct allocations
+    {
+        std::size_t count; // Calls to operator new since the process started
+        std::size_t bytes; // Bytes requested by those calls
+        std::size_t live;  // Heap bytes currently in use, including allocator overhead
+    };
+
+    [[nodiscard]] allocations allocated();
+
+    // Keeps the compiler from optimizing away a result that is otherwise unused
+    template <typename T>
+    void keep(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // Mean time of a single call in nanoseconds, after one call to warm up caches
+    template <typename T>
+    double time(std::size_t iterations, T &&fn)
+    {
+        keep(fn());
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto i = 0uz; iterations > i; ++i)
+        {
+            keep(fn());
+        }
+
+        const auto elapsed = std::chrono::duration<double, std::nano>{std::chrono::steady_clock::now() - start};
+
+        return elapsed.count() / static_cast<double>(iterations);
+    }
+
+    int matcher();
+    int properties();
+    int kernels();
+    int latency();
+} // namespace bench
@@ -0,0 +1,59 @@
+#include "bench.hpp"
+#include "kernels.hpp"
+
+#include <span>
+#include <print>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+namespace bench
+{
+    int kernels()
+    {
+        static constexpr auto sources = 10uz;
+
+        const auto selected = vencord::kernels::name();
+        auto engine         = std::mt19937{42};
+        auto distribution   = std::uniform_real_distribution{-0.5f, 0.5f};
+
+        std::println("{:>8} {:>10} {:>20}", "quantum", "kernels", "ns per quantum");
+
+        for (const auto quantum : {128uz, 256uz, 1024uz})
+        {
+            auto inputs = std::vector<std::vector<float>>(sources, std::vector<float>(quantum));
+            auto output = std::vector<float>(quantum);
+
+            for (auto &input : inputs)
+            {
+                std::ranges::generate(input, [&] { return distribution(engine); });
+            }
+
+            // One channel of a mixer cycle: every source is measured and summed, then the sum is clipped
+            const auto cycle = [&]
+            {
+                std::ranges::fill(output, 0.0f);
+
+                for (const auto &input : inputs)
+                {
+                    keep(vencord::kernels::measure(input));
+                    vencord::kernels::mix(output, input, 1.0f);
+                }
+
+                vencord::kernels::clip(output);
+
+                return output.front();
+            };
+
+            for (const auto *name : vencord::kernels::available())
+            {
+                vencord::kernels::use(name);
+                std::println("{:>8} {:>10} {:>20.0f}", quantum, name, time(100'000, cycle));
+            }
+        }
+
+        vencord::kernels::use(selected);
+
+        return 0;
+    }
+} // namespace bench
@@ -0,0 +1,76 @@
+#include "bench.hpp"
+
+#include <vencord/patchbay.hpp>
+
+#include <array>
+#include <print>
+#include <chrono>
+#include <thread>
+#include <numeric>
+#include <string_view>
+
+namespace bench
+{
+    int latency()
+    {
+        using namespace std::chrono_literals;
+
+        struct setup
+        {
+            std::string_view name;
+            bool duplex;
+            bool mixer;
+        };
+
+        static constexpr auto setups = std::array{
+            setup{"sink+source", false, false},
+            setup{"duplex", true, false},
+            setup{"mixer", false, true},
+        };
+
+        if (!vencord::patchbay::has_pipewire())
+        {
+            std::println(stderr, "no pipewire server available");
+            return 1;
+        }
+
+        auto &patchbay = vencord::patchbay::get();
+
+        std::println("{:>12} {:>6} {:>14} {:>10}", "setup", "nodes", "max quanta", "max ms");
+
+        // Every node playing to the default speaker is captured, so something has to be playing while this runs
+        for (const auto &[name, duplex, mixer] : setups)
+        {
+            patchbay.link({
+                .exclude = {{{"node.name", "venmic-bench"}}},
+                .mute    = false,
+                .mixer   = mixer,
+                .duplex  = duplex,
+            });
+
+            // Give the server time to create the setup and to settle the latency of every path
+            std::this_thread::sleep_for(2s);
+
+            const auto latencies = patchbay.measure();
+
+            if (latencies.empty())
+            {
+                std::println("{:>12} nothing is playing to the default speaker", name);
+                continue;
+            }
+
+            const auto count   = static_cast<double>(latencies.size());
+            const auto quanta  = std::accumulate(latencies.begin(), latencies.end(), 0.0,
+                                                 [](double sum, const auto &item) { return sum + item.quantum[1]; });
+            const auto seconds = std::accumulate(latencies.begin(), latencies.end(), 0.0,
+                                                 [](double sum, const auto &item) { return sum + (item.total / 1e9); });
+
+            std::println("{:>12} {:>6} {:>14.2f} {:>10.2f}", name, latencies.size(), quanta / count,
+                         seconds * 1e3 / count);
+        }
+
+        patchbay.unlink();
+
+        return 0;
+    }
+} // namespace bench
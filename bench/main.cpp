@@ -0,0 +1,55 @@
+#include "bench.hpp"
+
+#include <array>
+#include <print>
+#include <ranges>
+#include <vector>
+#include <algorithm>
+#include <string_view>
+
+int main(int argc, char **args)
+{
+    struct suite
+    {
+        std::string_view name;
+        int (*run)();
+        bool pipewire; // Only run when selected explicitly
+    };
+
+    static constexpr auto suites = std::array{
+        suite{"matcher", &bench::matcher, false},
+        suite{"properties", &bench::properties, false},
+        suite{"kernels", &bench::kernels, false},
+        suite{"latency", &bench::latency, true},
+    };
+
+    const auto arguments = std::vector<std::string_view>(args, args + argc);
+    const auto selected  = arguments.size() > 1 ? arguments[1] : std::string_view{};
+
+    const auto run = [&](const suite &item)
+    {
+        return selected.empty() ? !item.pipewire : item.name == selected;
+    };
+
+    if (!selected.empty() && !std::ranges::any_of(suites, run))
+    {
+        std::println(stderr, "usage: {} [suite]", arguments[0]);
+
+        for (const auto &item : suites)
+        {
+            std::println(stderr, "  {}{}", item.name, item.pipewire ? " (needs a pipewire server)" : "");
+        }
+
+        return 1;
+    }
+
+    auto rtn = 0;
+
+    for (const auto &item : suites | std::views::filter(run))
+    {
+        std::println("[{}]", item.name);
+        rtn |= item.run();
+    }
+
+    return rtn;
+}
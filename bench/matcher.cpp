@@ -0,0 +1,112 @@
+#include "bench.hpp"
+#include "matcher.hpp"
+#include "properties.hpp"
+
+#include <print>
+#include <format>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace bench
+{
+    using dict = std::vector<std::pair<std::string, std::string>>;
+
+    // How rules were matched before they were compiled: every key of every rule is looked up linearly in the
+    // properties of the node, the way `spa_dict_lookup` does it, and compared as a copied string
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static bool matches(const std::vector<vencord::node> &targets, const dict &props)
+    {
+        const auto lookup = [&props](const std::string &key)
+        {
+            const auto it = std::ranges::find(props, key, &dict::value_type::first);
+            return it == props.end() ? std::string{} : it->second;
+        };
+
+        const auto props_match = [&](const auto &prop)
+        {
+            return lookup(prop.first) == prop.second;
+        };
+
+        const auto has_target = [&](const auto &target)
+        {
+            return std::ranges::all_of(target, props_match);
+        };
+
+        return std::ranges::any_of(targets, has_target);
+    }
+
+    int matcher()
+    {
+        static constexpr auto node_count = 5000uz;
+        static constexpr auto prop_count = 20uz;
+
+        auto strings = vencord::interner{};
+        auto dicts   = std::vector<dict>{};
+        auto nodes   = std::vector<vencord::properties>{};
+
+        for (auto i = 0uz; node_count > i; ++i)
+        {
+            auto props = dict{
+                {"node.name", std::format("app-{}", i)},
+                {"application.name", std::format("App {}", i % 50)},
+                {"application.process.binary", std::format("bin-{}", i % 100)},
+                {"media.class", "Stream/Output/Audio"},
+                {"object.serial", std::to_string(i)},
+            };
+
+            for (auto key = props.size(); prop_count > key; ++key)
+            {
+                props.emplace_back(std::format("prop.{}", key), std::format("value-{}", i % 7));
+            }
+
+            nodes.emplace_back(strings, props);
+            dicts.emplace_back(std::move(props));
+        }
+
+        // Mostly single key rules that never match, like exclude lists of known system sounds
+        for (const auto rule_count : {10uz, 100uz, 500uz})
+        {
+            auto rules = std::vector<vencord::node>{};
+
+            for (auto rule = 0uz; rule_count > rule; ++rule)
+            {
+                if (rule % 10 == 0)
+                {
+                    rules.push_back({{"application.name", std::format("App {}", rule % 60)},
+                                     {"media.class", "Stream/Output/Audio"}});
+                    continue;
+                }
+
+                rules.push_back({{"node.name", std::format("system-sound-{}", rule)}});
+            }
+
+            const auto compiled = vencord::matcher{rules};
+
+            const auto linear = [&]
+            {
+                return std::ranges::count_if(dicts, [&](const auto &props) { return matches(rules, props); });
+            };
+
+            const auto grouped = [&]
+            {
+                return std::ranges::count_if(nodes, [&](const auto &props) { return compiled.matches(props); });
+            };
+
+            if (linear() != grouped())
+            {
+                std::println(stderr, "compiled matcher disagrees with the linear one ({} vs {})", grouped(), linear());
+                return 1;
+            }
+
+            const auto before = time(20, linear) / node_count;
+            const auto after  = time(20, grouped) / node_count;
+
+            std::println("{:>4} rules: {:>8.0f} ns per node linear, {:>6.0f} ns per node compiled ({:.1f}x)", rule_count,
+                         before, after, before / after);
+        }
+
+        return 0;
+    }
+} // namespace bench
@@ -0,0 +1,110 @@
+#include "bench.hpp"
+#include "properties.hpp"
+
+#include <map>
+#include <print>
+#include <format>
+#include <string>
+#include <vector>
+#include <utility>
+#include <string_view>
+
+namespace bench
+{
+    using source = std::vector<std::pair<std::string, std::string>>;
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static void report(std::string_view name, allocations before, allocations stored, allocations copied)
+    {
+        std::println("{:<12} stored: {:>7} allocations, {:>6.1f} MB allocated, {:>6.1f} MB live", name,
+                     stored.count - before.count, static_cast<double>(stored.bytes - before.bytes) / 1e6,
+                     static_cast<double>(stored.live - before.live) / 1e6);
+
+        std::println("{:<12} per event: {:>7} allocations to read every node's properties", name,
+                     copied.count - stored.count);
+    }
+
+    int properties()
+    {
+        static constexpr auto node_count = 5000uz;
+        static constexpr auto prop_count = 30uz;
+
+        auto sources = std::vector<source>{};
+
+        // One in five values is unique to its node (names, serials, ids), the rest recur across the graph
+        for (auto node = 0uz; node_count > node; ++node)
+        {
+            auto &props = sources.emplace_back();
+
+            for (auto key = 0uz; prop_count > key; ++key)
+            {
+                auto value = key % 5 == 0 ? std::format("unique-value-{}-{}", node, key)
+                                          : std::format("shared-value-{}-{}", key, node % 4);
+
+                props.emplace_back(std::format("some.property.key.{}", key), std::move(value));
+            }
+        }
+
+        {
+            const auto before = allocated();
+            auto maps         = std::vector<std::map<std::string, std::string>>{};
+
+            maps.reserve(node_count);
+
+            for (const auto &props : sources)
+            {
+                maps.emplace_back(props.begin(), props.end());
+            }
+
+            const auto stored = allocated();
+
+            // Evaluating a node used to copy its properties
+            for (const auto &map : maps)
+            {
+                auto copy = map;
+                keep(copy.size());
+            }
+
+            report("std::map", before, stored, allocated());
+        }
+
+        {
+            const auto before = allocated();
+            auto strings      = vencord::interner{};
+            auto cached       = std::vector<vencord::properties>{};
+
+            cached.reserve(node_count);
+
+            for (const auto &props : sources)
+            {
+                cached.emplace_back(strings, props);
+            }
+
+            const auto stored = allocated();
+
+            for (const auto &props : cached)
+            {
+                keep(props["some.property.key.0"].size());
+            }
+
+            report("interned", before, stored, allocated());
+
+            std::println("{:<12} {} distinct strings in {:.1f} MB of blocks", "", strings.size(),
+                         static_cast<double>(strings.capacity()) / 1e6);
+
+            cached.clear();
+
+            const auto reused = allocated();
+
+            for (const auto &props : sources)
+            {
+                cached.emplace_back(strings, props);
+            }
+
+            std::println("{:<12} rebuilt after releasing everything: {} allocations, {:.1f} MB of blocks", "",
+                         allocated().count - reused.count, static_cast<double>(strings.capacity()) / 1e6);
+        }
+
+        return 0;
+    }
+} // namespace bench
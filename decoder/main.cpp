@@ -0,0 +1,71 @@
+#include <vencord/recorder.hpp>
+
+#include <print>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+int main(int argc, char **args)
+{
+    using vencord::recorder;
+
+    const auto arguments = std::vector<std::string_view>(args, args + argc);
+    const auto path      = arguments.size() > 1 ? std::filesystem::path{arguments[1]} : recorder::path();
+
+    auto file = std::ifstream{path, std::ios::binary};
+
+    if (!file)
+    {
+        std::println(stderr, "could not open {}", path.string());
+        return 1;
+    }
+
+    const auto data = std::vector<char>{std::istreambuf_iterator<char>{file}, {}};
+    auto header     = recorder::header{};
+
+    if (data.size() < sizeof(header))
+    {
+        std::println(stderr, "{} is too small to be an event log", path.string());
+        return 1;
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (header.magic != recorder::magic || header.version != recorder::version)
+    {
+        std::println(stderr, "{} is not an event log of this version", path.string());
+        return 1;
+    }
+
+    if (data.size() < sizeof(header) + (header.capacity * sizeof(recorder::record)))
+    {
+        std::println(stderr, "{} is truncated", path.string());
+        return 1;
+    }
+
+    const auto first = header.head > header.capacity ? header.head - header.capacity : 0;
+
+    for (auto index = first; index < header.head; ++index)
+    {
+        auto record        = recorder::record{};
+        const auto *source = data.data() + sizeof(header) + ((index % header.capacity) * sizeof(record));
+
+        std::memcpy(&record, source, sizeof(record));
+
+        // The record was being written when the file was captured
+        if (record.sequence != static_cast<std::uint32_t>(index + 1))
+        {
+            continue;
+        }
+
+        const auto time   = std::chrono::sys_time<std::chrono::nanoseconds>{std::chrono::nanoseconds{record.timestamp}};
+        const auto format = recorder::describe(record.id);
+        auto &[a, b, c, d, e, f] = record.args;
+
+        std::println("[{:%F %T}] {}", time, std::vformat(format, std::make_format_args(a, b, c, d, e, f)));
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <vencord/capture.hpp>
+
+#include <print>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+static constexpr auto margin = std::uint64_t{8192}; // Largest quantum PipeWire uses by default, in frames
+
+template <typename T>
+void put(std::ofstream &file, T value)
+{
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+int main(int argc, char **args)
+{
+    using vencord::capture_file;
+
+    const auto arguments = std::vector<std::string_view>(args, args + argc);
+    auto seconds         = std::uint32_t{};
+
+    const auto parse = [&seconds](std::string_view value)
+    {
+        return std::from_chars(value.data(), value.data() + value.size(), seconds).ec == std::errc{};
+    };
+
+    if (arguments.size() < 2 || !parse(arguments[1]))
+    {
+        std::println(stderr, "usage: {} <seconds> [output.wav] [capture]", arguments[0]);
+        return 1;
+    }
+
+    const auto output = arguments.size() > 2 ? std::filesystem::path{arguments[2]} : "venmic-capture.wav";
+    const auto path   = arguments.size() > 3 ? std::filesystem::path{arguments[3]} : capture_file::path();
+
+    auto file = std::ifstream{path, std::ios::binary};
+
+    if (!file)
+    {
+        std::println(stderr, "could not open {}", path.string());
+        return 1;
+    }
+
+    // The capture keeps running while we read it, so everything is read at once and the frames it may have overwritten
+    // in the meantime are skipped below
+    const auto data = std::vector<char>{std::istreambuf_iterator<char>{file}, {}};
+    auto header     = capture_file::header{};
+
+    if (data.size() < sizeof(header))
+    {
+        std::println(stderr, "{} is too small to be a capture", path.string());
+        return 1;
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (header.magic != capture_file::magic || header.version != capture_file::version)
+    {
+        std::println(stderr, "{} is not a capture of this version", path.string());
+        return 1;
+    }
+
+    const auto frame_size = std::size_t{header.channels} * sizeof(float);
+
+    if (!header.capacity || !header.rate || data.size() < sizeof(header) + (header.capacity * frame_size))
+    {
+        std::println(stderr, "{} is empty or truncated", path.string());
+        return 1;
+    }
+
+    // Whatever the writer reached by the time everything was copied may be torn, as may be the frames of the quantum it
+    // was writing but had not published yet
+    auto head = header.head;
+
+    file.clear();
+    file.seekg(offsetof(capture_file::header, head));
+    file.read(reinterpret_cast<char *>(&head), sizeof(head));
+
+    const auto reached   = head + margin;
+    const auto oldest    = reached > header.capacity ? reached - header.capacity : 0;
+    const auto available = header.head > oldest ? header.head - oldest : 0;
+    const auto frames    = std::min<std::uint64_t>(available, std::uint64_t{seconds} * header.rate);
+    const auto *samples  = data.data() + sizeof(header);
+
+    auto wav = std::ofstream{output, std::ios::binary};
+
+    if (!wav)
+    {
+        std::println(stderr, "could not create {}", output.string());
+        return 1;
+    }
+
+    const auto size = static_cast<std::uint32_t>(frames * frame_size);
+
+    wav.write("RIFF", 4);
+    put<std::uint32_t>(wav, 36 + size);
+    wav.write("WAVEfmt ", 8);
+    put<std::uint32_t>(wav, 16);
+    put<std::uint16_t>(wav, 3); // IEEE float
+    put<std::uint16_t>(wav, static_cast<std::uint16_t>(header.channels));
+    put<std::uint32_t>(wav, header.rate);
+    put<std::uint32_t>(wav, static_cast<std::uint32_t>(header.rate * frame_size));
+    put<std::uint16_t>(wav, static_cast<std::uint16_t>(frame_size));
+    put<std::uint16_t>(wav, 32);
+    wav.write("data", 4);
+    put<std::uint32_t>(wav, size);
+
+    for (auto index = header.head - frames; header.head > index; ++index)
+    {
+        wav.write(samples + ((index % header.capacity) * frame_size), static_cast<std::streamsize>(frame_size));
+    }
+
+    std::println("wrote {:.1f}s of {} channel(s) at {} Hz to {}", static_cast<double>(frames) / header.rate,
+                 header.channels, header.rate, output.string());
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+
+namespace vencord
+{
+    // Layout of the ring file the shared stream is captured into, see `patchbay::start_capture`
+    struct capture_file
+    {
+        // Followed by `capacity` frames of interleaved 32 bit float samples
+        struct header
+        {
+            std::array<char, 8> magic;
+            std::uint32_t version;
+            std::uint32_t channels;
+            std::uint32_t capacity; // In frames
+            std::uint32_t rate;     // Rate of the most recent quantum, only accessed atomically
+            std::uint64_t head;     // Total amount of frames written, only accessed atomically
+        };
+
+      public:
+        static constexpr auto magic   = std::array{'V', 'E', 'N', 'M', 'I', 'C', 'C', 'P'};
+        static constexpr auto version = std::uint32_t{1};
+
+      public:
+        [[nodiscard]] static std::filesystem::path path();
+    };
+
+    static_assert(sizeof(capture_file::header) == 32);
+} // namespace vencord
@@ -2,6 +2,11 @@
 
 #include <memory>
 #include <format>
+#include <filesystem>
+
+#ifndef VENMIC_MIN_LOG_LEVEL
+#define VENMIC_MIN_LOG_LEVEL 0
+#endif
 
 namespace vencord
 {
@@ -16,11 +21,15 @@ namespace vencord
             error,
         };
 
+      public:
+        static constexpr auto minimum = static_cast<level>(VENMIC_MIN_LOG_LEVEL); // Lower levels are never formatted
+
       private:
         struct impl;
 
       private:
         std::unique_ptr<impl> m_impl;
+        level m_threshold; // Lowest level any sink accepts, fixed after construction
 
       private:
         logger();
@@ -28,6 +37,9 @@ namespace vencord
       private:
         void log(level, std::string_view) const;
 
+      public:
+        [[nodiscard]] bool enabled(level) const;
+
       public:
         template <typename... Ts>
         void operator()(std::format_string<Ts...>, Ts &&...) const;
@@ -37,6 +49,7 @@ namespace vencord
 
       public:
         [[nodiscard]] static logger &get();
+        [[nodiscard]] static std::filesystem::path directory();
     };
 } // namespace vencord
 
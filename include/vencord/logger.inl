@@ -4,15 +4,25 @@
 
 namespace vencord
 {
+    inline bool logger::enabled(logger::level level) const
+    {
+        return level >= minimum && level >= m_threshold;
+    }
+
     template <typename... Ts>
     void logger::operator()(logger::level level, std::format_string<Ts...> format, Ts &&...args) const
     {
+        if (!enabled(level))
+        {
+            return;
+        }
+
         return log(level, std::format(format, std::forward<Ts>(args)...));
     }
 
     template <typename... Ts>
     void logger::operator()(std::format_string<Ts...> format, Ts &&...args) const
     {
-        return log(level::info, std::format(format, std::forward<Ts>(args)...));
+        return operator()(level::info, format, std::forward<Ts>(args)...);
     }
 } // namespace vencord
@@ -4,7 +4,9 @@
 #include <string>
 
 #include <map>
+#include <array>
 #include <vector>
+#include <cstdint>
 
 namespace vencord
 {
@@ -25,6 +27,52 @@ namespace vencord
                                           //
       public:                             //
         std::vector<node> workaround;     // Nodes given here will automatically be linked to the venmic node
+                                          //
+      public:                             //
+        bool direct{false};               // Link matching ports directly instead of loading a loopback per node
+        bool mixer{false};                // Mix all linked nodes in-process instead of using a sink and a source
+        bool meter{false};                // Measure the levels of every linked node, see `patchbay::levels`
+        bool duplex{false};               // Feed a single virtual source directly instead of bridging a sink into it
+
+      public:
+        std::vector<std::string> positions{"FL", "FR"}; // Channel layout of the sharing node, empty to follow the speaker
+        std::uint32_t rate{0};                          // Sample rate of the sharing node, 0 to follow the graph
+
+      public:
+        std::uint32_t latency{0};  // Requested quantum of the sharing nodes in samples, 0 to leave it to the graph
+        bool force_quantum{false}; // Force the requested quantum on the whole graph until unlinked
+
+      public:
+        std::uint32_t gate{0}; // Milliseconds of silence after which a node stops being captured, 0 to never gate
+    };
+
+    struct level
+    {
+        std::uint32_t node;
+        std::array<float, 2> peak; // Per channel (FL, FR), of the most recent quantum
+        std::array<float, 2> rms;  // Per channel (FL, FR), of the most recent quantum
+    };
+
+    struct latency
+    {
+        std::uint32_t node;
+        std::array<float, 2> quantum;      // Minimum and maximum, in multiples of the graph quantum
+        std::array<std::uint32_t, 2> rate; // Minimum and maximum, in samples
+        std::array<std::uint64_t, 2> ns;   // Minimum and maximum, in nanoseconds
+        std::uint64_t total;               // Maximum in nanoseconds, at the configured quantum and clock rate
+    };
+
+    struct load
+    {
+        std::uint32_t node;
+        std::string name;
+        std::uint64_t xruns;  // Since venmic started tracking the node
+        std::uint32_t cycles; // Cycles in the rolling window
+                              //
+      public:                 //
+        float busy;           // Average share of the quantum spent processing, within the window
+        float wait;           // Average share of the quantum spent waiting to be woken up, within the window
+        float peak;           // Highest share of the quantum spent processing, within the window
     };
 
     struct patchbay
@@ -47,11 +95,24 @@ namespace vencord
         void unlink();
         void unmute();
 
+      public:
+        void start_capture(std::uint32_t seconds); // Keeps the last seconds of the shared stream, see `capture_file`
+        void stop_capture();
+
       public:
         [[nodiscard]] std::vector<node> list(std::vector<std::string> props);
+        [[nodiscard]] std::vector<level> levels() const; // Does not block the pipewire thread
+        [[nodiscard]] std::vector<latency> measure();    // Latency from every linked node to the virtual microphone
+        [[nodiscard]] std::vector<load> telemetry();     // Xruns and DSP load of the nodes venmic owns
+        [[nodiscard]] std::string metrics() const;       // Prometheus text format, does not block the pipewire thread
+        [[nodiscard]] std::string spans() const;         // Chrome trace of the most recent spans, does not block either
 
       public:
         [[nodiscard]] static patchbay &get();
         [[nodiscard]] static bool has_pipewire();
+
+      public:
+        // Whether the given properties satisfy any of the rules, the same way `include` and `exclude` are evaluated
+        [[nodiscard]] static bool matches(const std::vector<node> &rules, const node &props);
     };
 } // namespace vencord
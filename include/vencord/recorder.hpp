@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <concepts>
+#include <filesystem>
+#include <string_view>
+
+namespace vencord
+{
+    // Writes fixed-size binary records into a memory-mapped ring file, decoded offline by `venmic-decoder`
+    struct recorder
+    {
+        enum class event : std::uint16_t
+        {
+            node_added,
+            port_added,
+            link_added,
+            metadata_added,
+            global_removed,
+            link_accepted,
+            link_rejected,
+            mixed,
+            routed,
+            loopback_created,
+            loopback_failed,
+            redirected,
+            muted,
+            quantum_forced,
+            flushed,
+            relinked,
+            gated,
+            ungated,
+        };
+
+      public:
+        struct record
+        {
+            std::uint64_t timestamp; // Nanoseconds since the unix epoch
+            std::uint32_t sequence;  // Index of the record plus one, written last
+            event id;
+            std::uint16_t count;
+            std::array<std::uint32_t, 6> args;
+        };
+
+        struct header
+        {
+            std::array<char, 8> magic;
+            std::uint32_t version;
+            std::uint32_t capacity;
+            std::uint64_t head; // Total amount of records written, only accessed atomically
+        };
+
+      public:
+        static constexpr auto magic    = std::array{'V', 'E', 'N', 'M', 'I', 'C', 'E', 'V'};
+        static constexpr auto version  = std::uint32_t{1};
+        static constexpr auto capacity = std::uint32_t{1} << 16;
+
+      private:
+        struct impl;
+
+      private:
+        std::unique_ptr<impl> m_impl;
+
+      private:
+        recorder();
+
+      private:
+        void write(event, std::array<std::uint32_t, 6>, std::uint16_t) const;
+
+      public:
+        template <std::integral... Ts>
+            requires(sizeof...(Ts) <= 6)
+        void operator()(event, Ts...) const;
+
+      public:
+        [[nodiscard]] static recorder &get();
+        [[nodiscard]] static std::filesystem::path path();
+        [[nodiscard]] static std::string_view describe(event); // Format string of the equivalent log message
+    };
+
+    static_assert(sizeof(recorder::record) == 40);
+    static_assert(sizeof(recorder::header) == 24);
+} // namespace vencord
+
+#include "recorder.inl"
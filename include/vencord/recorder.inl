@@ -0,0 +1,13 @@
+#pragma once
+
+#include "recorder.hpp"
+
+namespace vencord
+{
+    template <std::integral... Ts>
+        requires(sizeof...(Ts) <= 6)
+    void recorder::operator()(event id, Ts... args) const
+    {
+        return write(id, {static_cast<std::uint32_t>(args)...}, sizeof...(Ts));
+    }
+} // namespace vencord
@@ -10,12 +10,15 @@ type Optional<
     Key extends keyof Type
 > = Partial<Pick<Type, Key>> & Omit<Type, Key>;
 
+export type Pattern = `prefix:${string}` | `glob:${string}` | `regex:${string}` | `exact:${string}`;
+
 export type Node<T extends string = never> = Record<LiteralUnion<T, string>, string>;
+export type Rule<T extends string = never> = Record<LiteralUnion<T, string>, LiteralUnion<Pattern, string>>;
 
 export interface LinkData
 {
-    include: Node[];
-    exclude: Node[];
+    include: Rule[];
+    exclude: Rule[];
 
     only_speakers?: boolean;
     only_default_speakers?: boolean;
@@ -23,16 +26,70 @@ export interface LinkData
     ignore_devices?: boolean;
     
     mute?: boolean;
-    workaround?: Node[];
+    workaround?: Rule[];
+
+    direct?: boolean;
+    mixer?: boolean;
+    meter?: boolean;
+    duplex?: boolean;
+
+    positions?: string[];
+    rate?: number;
+
+    latency?: number;
+    force_quantum?: boolean;
+
+    gate?: number;
+}
+
+export interface Level
+{
+    node: number;
+    peak: [number, number];
+    rms: [number, number];
+}
+
+export interface Latency
+{
+    node: number;
+    quantum: [number, number];
+    rate: [number, number];
+    ns: [number, number];
+    total: number;
+}
+
+export interface Load
+{
+    node: number;
+    name: string;
+    xruns: number;
+    cycles: number;
+    busy: number;
+    wait: number;
+    peak: number;
 }
 
 export class PatchBay
 {
     unlink(): void;
     unmute(): void;
+
+    startCapture(seconds?: number): void;
+    stopCapture(): void;
     
     list<T extends string = DefaultProps>(props?: T[]): Node<T>[];
     link(data: Optional<LinkData, "exclude"> | Optional<LinkData, "include">): boolean;
 
+    listAsync<T extends string = DefaultProps>(props?: T[]): Promise<Node<T>[]>;
+    /** Resolves once the request is queued, not once the virtual microphone was set up */
+    linkAsync(data: Optional<LinkData, "exclude"> | Optional<LinkData, "include">): Promise<boolean>;
+    measureAsync(): Promise<Latency[]>;
+    telemetryAsync(): Promise<Load[]>;
+
+    levels(): Level[];
+    measure(): Latency[];
+    telemetry(): Load[];
+
     static hasPipeWire(): boolean;
+    static matches(rules: Rule[], node: Node): boolean;
 }
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace vencord
+{
+    struct adjacency
+    {
+        using peers = std::unordered_map<std::uint32_t, std::size_t>; // node -> link count
+
+      private:
+        std::unordered_map<std::uint32_t, peers> m_outputs;
+        std::unordered_map<std::uint32_t, peers> m_inputs;
+
+      public:
+        bool add(std::uint32_t from, std::uint32_t to);    // Returns whether `from` gained a new target
+        bool remove(std::uint32_t from, std::uint32_t to); // Returns whether `from` lost a target
+
+      public:
+        [[nodiscard]] bool feeds(std::uint32_t from, std::uint32_t to) const;
+
+      public:
+        [[nodiscard]] const peers &outputs(std::uint32_t) const; // Nodes the given node plays to
+        [[nodiscard]] const peers &inputs(std::uint32_t) const;  // Nodes that play to the given node
+    };
+} // namespace vencord
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "capture.hpp"
+
+#include <span>
+#include <memory>
+#include <cstdint>
+
+namespace vencord
+{
+    // Writes interleaved samples into a memory-mapped `capture_file`, never blocks and never allocates while writing
+    struct capture_ring
+    {
+        struct impl;
+
+      private:
+        std::unique_ptr<impl> m_impl;
+
+      private:
+        capture_ring();
+
+      public:
+        ~capture_ring();
+
+      public:
+        // Every channel is expected to hold the same amount of samples
+        void write(std::span<const std::span<const float>> channels, std::uint32_t rate);
+
+      public:
+        [[nodiscard]] static std::shared_ptr<capture_ring> create(const std::filesystem::path &, std::uint32_t channels,
+                                                                  std::uint32_t frames);
+    };
+} // namespace vencord
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "interner.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+#include <unordered_set>
+#include <unordered_map>
+#include <initializer_list>
+
+namespace vencord
+{
+    struct property_index
+    {
+        using ids       = std::unordered_set<std::uint32_t>;
+        using value_map = std::unordered_map<std::string_view, ids, string_hash, std::equal_to<>>;
+
+      private:
+        interner *m_strings;
+        string_map<value_map> m_index; // key -> value -> nodes, values are interned
+
+      public:
+        property_index(interner &, std::initializer_list<std::string_view>);
+
+      public:
+        property_index(const property_index &) = delete;
+        property_index &operator=(const property_index &) = delete;
+
+      public:
+        ~property_index();
+
+      public:
+        template <typename T>
+        void add(std::uint32_t, const T &props);
+
+        template <typename T>
+        void remove(std::uint32_t, const T &props);
+
+      public:
+        [[nodiscard]] bool indexed(std::string_view key) const;
+        [[nodiscard]] const ids &find(std::string_view key, std::string_view value) const;
+    };
+} // namespace vencord
+
+#include "index.inl"
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "index.hpp"
+
+namespace vencord
+{
+    template <typename T>
+    void property_index::add(std::uint32_t id, const T &props)
+    {
+        for (auto &[key, values] : m_index)
+        {
+            if (!props.contains(key))
+            {
+                continue;
+            }
+
+            const auto value = std::string_view{props.at(key)};
+            auto it          = values.find(value);
+
+            if (it == values.end())
+            {
+                it = values.emplace(m_strings->intern(value), ids{}).first;
+            }
+
+            it->second.emplace(id);
+        }
+    }
+
+    template <typename T>
+    void property_index::remove(std::uint32_t id, const T &props)
+    {
+        for (auto &[key, values] : m_index)
+        {
+            if (!props.contains(key))
+            {
+                continue;
+            }
+
+            const auto it = values.find(props.at(key));
+
+            if (it == values.end())
+            {
+                continue;
+            }
+
+            it->second.erase(id);
+
+            if (!it->second.empty())
+            {
+                continue;
+            }
+
+            const auto value = it->first;
+
+            values.erase(it);
+            m_strings->release(value);
+        }
+    }
+} // namespace vencord
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <string_view>
+
+#include <functional>
+#include <unordered_map>
+
+namespace vencord
+{
+    struct string_hash
+    {
+        using is_transparent = void;
+
+      public:
+        [[nodiscard]] std::size_t operator()(std::string_view) const;
+    };
+
+    template <typename T>
+    using string_map = std::unordered_map<std::string, T, string_hash, std::equal_to<>>;
+
+    // Interned strings live in fixed-size blocks, storage of released strings is reused for strings of similar size
+    struct interner
+    {
+        static constexpr auto block_size = 64uz * 1024;
+        static constexpr auto granule    = 16uz;
+
+      private:
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+        std::size_t m_used{block_size}; // Bytes handed out from the most recent block
+        std::size_t m_capacity{0};
+
+      private:
+        std::unordered_map<std::size_t, std::vector<char *>> m_free;              // granules -> released storage
+        std::unordered_map<std::string_view, std::size_t, string_hash> m_strings; // views into the blocks -> references
+
+      private:
+        [[nodiscard]] char *allocate(std::size_t granules);
+        void deallocate(char *, std::size_t granules);
+
+      public:
+        [[nodiscard]] std::string_view intern(std::string_view);
+        void release(std::string_view);
+
+      public:
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] std::size_t capacity() const; // Bytes reserved for strings
+    };
+} // namespace vencord
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <string_view>
+
+namespace vencord::kernels
+{
+    struct measurement
+    {
+        float peak;
+        float rms;
+    };
+
+    // Adds `src * gain` onto `dst`, both spans are expected to be of the same size
+    void mix(std::span<float> dst, std::span<const float> src, float gain);
+
+    // Limits every sample of `dst` to [-1, 1]
+    void clip(std::span<float> dst);
+
+    // Computes the absolute peak and the root mean square of `src`
+    [[nodiscard]] measurement measure(std::span<const float> src);
+
+    // Name of the implementation selected for the current CPU (i.e. "avx2", "sse" or "scalar")
+    [[nodiscard]] const char *name();
+
+    // Names of every implementation the current CPU supports, from slowest to fastest
+    [[nodiscard]] std::vector<const char *> available();
+
+    // Atomically switches every caller to the given implementation, only meant for the benchmarks.
+    // Returns false if it is not supported
+    bool use(std::string_view name);
+} // namespace vencord::kernels
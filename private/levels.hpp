@@ -0,0 +1,44 @@
+#pragma once
+
+#include "patchbay.hpp"
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <vector>
+#include <cstdint>
+
+namespace vencord
+{
+    // Levels are written from the processing thread and read from any thread without taking a lock
+    struct level_table
+    {
+        static constexpr auto capacity = 128uz;
+        static constexpr auto unused   = std::numeric_limits<std::uint32_t>::max();
+
+      public:
+        struct slot
+        {
+            std::atomic<std::uint32_t> node{unused};
+
+          public:
+            std::array<std::atomic<float>, 2> peak{};
+            std::array<std::atomic<float>, 2> rms{};
+            std::array<std::atomic<float>, 2> held{}; // Highest peak since the last `drain`
+        };
+
+      private:
+        std::array<slot, capacity> m_slots;
+
+      public:
+        [[nodiscard]] slot *acquire(std::uint32_t node); // Returns nullptr if all slots are in use
+        void release(slot *);
+
+      public:
+        [[nodiscard]] std::vector<level> read() const;
+        [[nodiscard]] std::vector<level> drain(); // Like `read`, but reports the held peaks and resets them
+
+      public:
+        static void hold(std::atomic<float> &, float peak); // Only raises the held peak, safe on the processing thread
+    };
+} // namespace vencord
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "patchbay.hpp"
+#include "interner.hpp"
+
+#include <regex>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+
+namespace vencord
+{
+    struct pattern
+    {
+        // Regular expressions run on the PipeWire thread for every new node, longer ones are rejected as invalid
+        static constexpr auto max_expression = 256uz;
+
+      public:
+        enum class kind : std::uint8_t
+        {
+            prefix,
+            glob,
+            regex,
+        };
+
+      public:
+        kind type;
+        std::string value;
+        std::optional<std::regex> expression;
+
+      public:
+        [[nodiscard]] bool matches(std::string_view) const;
+
+      public:
+        // Values are matched exactly unless they are prefixed with `prefix:`, `glob:` or `regex:`.
+        // A value that should be matched literally despite such a prefix can be written as `exact:<value>`.
+        [[nodiscard]] static std::optional<pattern> parse(std::string &value);
+    };
+
+    struct matcher
+    {
+        using rules = std::vector<std::uint32_t>;
+
+      private:
+        struct group
+        {
+            std::string key;
+            string_map<rules> values;                                // value -> rules requiring it
+            std::vector<std::pair<pattern, std::uint32_t>> patterns; // pattern -> rule requiring it
+        };
+
+        struct condition
+        {
+            std::string key;
+            std::string value;                 // Compared exactly, unless a pattern is set
+            std::optional<pattern> expression;
+        };
+
+      private:
+        bool m_always{false};
+        std::vector<group> m_groups;                 // One group per distinct key a rule starts with
+        std::vector<std::vector<condition>> m_rests; // rule -> remaining keys, checked once the first one matched
+
+      public:
+        matcher() = default;
+        matcher(const std::vector<node> &);
+
+      public:
+        template <typename T>
+        [[nodiscard]] bool matches(const T &props) const;
+
+      public:
+        [[nodiscard]] bool empty() const;
+    };
+} // namespace vencord
+
+#include "matcher.inl"
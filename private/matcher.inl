@@ -0,0 +1,52 @@
+#pragma once
+
+#include "matcher.hpp"
+
+namespace vencord
+{
+    template <typename T>
+    bool matcher::matches(const T &props) const
+    {
+        if (m_always)
+        {
+            return true;
+        }
+
+        // Absent keys compare as empty values, so that rules keep matching exactly as `props[key] == value` would
+        const auto lookup = [&props](const std::string &key)
+        {
+            return props.contains(key) ? std::string_view{props.at(key)} : std::string_view{};
+        };
+
+        const auto satisfied = [&lookup](const condition &item)
+        {
+            const auto value = lookup(item.key);
+            return item.expression.has_value() ? item.expression->matches(value) : value == item.value;
+        };
+
+        const auto hit = [&](std::uint32_t rule)
+        {
+            return std::ranges::all_of(m_rests[rule], satisfied);
+        };
+
+        for (const auto &[key, values, patterns] : m_groups)
+        {
+            const auto value = lookup(key);
+
+            if (const auto it = values.find(value); it != values.end() && std::ranges::any_of(it->second, hit))
+            {
+                return true;
+            }
+
+            for (const auto &[pattern, rule] : patterns)
+            {
+                if (pattern.matches(value) && hit(rule))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+} // namespace vencord
@@ -24,6 +24,23 @@ namespace vencord
     {
     };
 
+    struct measure
+    {
+    };
+
+    struct telemetry
+    {
+    };
+
+    struct start_capture
+    {
+        std::uint32_t seconds;
+    };
+
+    struct stop_capture
+    {
+    };
+
     struct quit
     {
     };
@@ -33,6 +50,7 @@ namespace vencord
         bool success{true};
     };
 
-    using pw_recipe = pw::recipe<list, link_options, unlink, unmute, quit>;
-    using cr_recipe = cr::recipe<std::vector<node>, ready, quit>;
+    using pw_recipe =
+        pw::recipe<list, link_options, unlink, unmute, measure, telemetry, start_capture, stop_capture, quit>;
+    using cr_recipe = cr::recipe<std::vector<node>, std::vector<latency>, std::vector<load>, ready, quit>;
 } // namespace vencord
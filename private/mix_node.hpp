@@ -0,0 +1,58 @@
+#pragma once
+
+#include "levels.hpp"
+#include "capture_ring.hpp"
+
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <optional>
+
+struct pw_core;
+
+namespace vencord
+{
+    struct mix_node
+    {
+        struct impl;
+
+      public:
+        enum class kind : std::uint8_t
+        {
+            mixer,   // Sums all inputs into a stereo output
+            meter,   // Only measures its inputs, has no outputs
+            capture, // Writes the sum of its inputs to a capture ring, has no outputs
+        };
+
+      private:
+        std::shared_ptr<impl> m_impl;
+
+      private:
+        mix_node();
+
+      public:
+        ~mix_node();
+
+      public:
+        [[nodiscard]] std::optional<std::uint32_t> id() const; // Available once the node was registered
+
+      public:
+        void mute(bool);
+        void meter(std::shared_ptr<level_table>);   // Publishes the levels of all inputs to the given table, if any
+        void capture(std::shared_ptr<capture_ring>); // Only used by captures, writes the sum of all inputs to the ring
+        void latency(const std::string &);           // Updates `node.latency` in place, empty to leave it to the graph
+
+      public:
+        // Adds a stereo input group for the given source, the group is removed once the returned handle is released
+        [[nodiscard]] std::shared_ptr<std::uint32_t> add(std::uint32_t source);
+
+      public:
+        [[nodiscard]] static std::string group(std::uint32_t source); // port.group of the inputs for the given source
+
+      public:
+        // Levels of every input are published to the given table, if any. The latency is given as `node.latency`
+        [[nodiscard]] static std::unique_ptr<mix_node> create(pw_core *, const std::string &name, kind,
+                                                              const std::string &latency   = {},
+                                                              std::shared_ptr<level_table> = {});
+    };
+} // namespace vencord
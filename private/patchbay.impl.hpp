@@ -2,10 +2,22 @@
 
 #include "patchbay.hpp"
 #include "message.hpp"
+#include "adjacency.hpp"
+#include "index.hpp"
+#include "matcher.hpp"
+#include "interner.hpp"
+#include "properties.hpp"
+#include "mix_node.hpp"
+#include "profiler.hpp"
+#include "statistics.hpp"
+#include "tracer.hpp"
 
+#include <mutex>
+#include <chrono>
 #include <thread>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <coco/stray/stray.hpp>
 
@@ -20,6 +32,9 @@
 #include <rohrkabel/metadata/events.hpp>
 #include <rohrkabel/metadata/metadata.hpp>
 
+#include <spa/support/loop.h>
+#include <spa/param/latency-utils.h>
+
 namespace vencord
 {
     struct speaker
@@ -34,6 +49,20 @@ namespace vencord
         pw::metadata_listener listener;
     };
 
+    struct audio_format
+    {
+        std::vector<std::string> positions;
+        std::uint32_t rate{0};    // Unset to follow the graph rate
+        std::uint32_t latency{0}; // Requested quantum in samples, unset to follow the graph
+
+      public:
+        // The latency is left out, the mixer applies it in place and only the null nodes are recreated for it
+        bool operator==(const audio_format &other) const
+        {
+            return positions == other.positions && rate == other.rate;
+        }
+    };
+
     struct share_node
     {
         pw::node loopback_receiver; // Node for Loopbacks to connect to (has to be Virtual/Sink)
@@ -41,6 +70,73 @@ namespace vencord
 
       public:
         std::vector<pw::link> links;
+        std::unique_ptr<mix_node> mixer; // Only set when mixing in-process, then both nodes refer to the mixer
+        bool duplex{false};              // Set when nodes feed the source directly, then both nodes refer to the source
+        audio_format format;             // Format of the null nodes, only the latency is set for the mixer
+        audio_format requested;          // Format as given in the link options, before it was resolved
+    };
+
+    using port_pairs = std::vector<std::pair<std::uint32_t, std::uint32_t>>; // output port -> input port
+
+    enum class mapping : std::uint8_t
+    {
+        exact,   // Every output needs an input of the same channel, otherwise nothing is routed
+        stereo,  // Outputs are folded into FL and FR, i.e. for the stereo inputs of venmic owned filters
+        partial, // Outputs without an input of the same channel are skipped, i.e. to capture FL and FR of wider nodes
+    };
+
+    struct tap
+    {
+        std::shared_ptr<std::uint32_t> input; // Input group on a venmic owned filter, unset for direct routes
+        port_pairs ports;
+        std::vector<pw::link> links;
+    };
+
+    struct loopback
+    {
+        pw::impl::module module;
+        tally unloaded; // Counts the unload in `loopbacks_destroyed` once the module is released
+    };
+
+    struct virt_link
+    {
+        std::uint32_t target;
+        std::optional<loopback> module;         // Only set for loopbacks
+        std::string conversion;                 // Remixing and resampling the link needs, empty if there is none
+
+      public:
+        tap route; // Direct routes and mixer inputs
+        tap meter; // Metering tap, unless the mixer measures the source itself
+
+      public:
+        tally gated; // Held while the node is silent, then its route is removed and only the meter tap is used
+        std::chrono::steady_clock::time_point heard{std::chrono::steady_clock::now()};
+    };
+
+    struct node_entry
+    {
+        properties props;
+        bool can_output;
+    };
+
+    struct port_entry
+    {
+        std::uint32_t id;
+        properties props;
+        pw::port_direction direction;
+    };
+
+    struct link_entry
+    {
+        std::uint32_t from;
+        std::uint32_t to;
+    };
+
+    struct link_rules
+    {
+        matcher include;
+        matcher exclude;
+        matcher workaround;
     };
 
     enum class clean : std::uint8_t
@@ -53,6 +149,11 @@ namespace vencord
     {
         std::unique_ptr<pw_recipe::sender> sender;
         std::unique_ptr<cr_recipe::receiver> receiver;
+        std::mutex requests; // Keeps responses in order when requests are made from multiple threads
+
+      public:
+        std::shared_ptr<level_table> levels{std::make_shared<level_table>()};
+        statistics stats;
 
       private:
         std::shared_ptr<pw::main_loop> loop;
@@ -64,18 +165,54 @@ namespace vencord
         std::optional<metadata> meta;
         std::optional<speaker> default_speaker;
 
+      private:
+        std::optional<metadata> settings;
+        std::map<std::string, std::string> clock;   // clock.* entries of the settings metadata
+        std::optional<std::string> restore_quantum; // Only set while forcing the quantum
+
+      private:
+        std::optional<std::uint32_t> profiler_id; // Set once the profiler module was announced
+        std::unique_ptr<profiler> profiling;      // Only bound while telemetry is requested
+        spa_source *profile_timer{nullptr};       // Releases the profiler once telemetry was not requested for a while
+        spa_source *warm_timer{nullptr};          // Answers the request that bound the profiler once it saw some cycles
+        std::optional<cr_recipe::sender> warming; // Only set while that request waits
+
       private:
         std::optional<vencord::link_options> options;
+        link_rules rules;
         std::shared_ptr<std::uint32_t> workaround_target;
 
       private:
         std::optional<share_node> virt_mic;
-        std::unordered_map<std::uint32_t, pw::impl::module> virt_links;
+        std::unique_ptr<mix_node> meters;                        // Only set when metering without the mixer
+        std::unique_ptr<mix_node> capturer;                      // Only set while capturing the shared stream
+        tap captured;                                            // Links from the sharing node into the capturer
+        std::uint64_t captures{0};                               // Bumped on every start and stop of a capture
+        std::unordered_map<std::uint32_t, virt_link> virt_links; // source node -> loopback or direct route
+        spa_source *gate_timer{nullptr}; // Periodically checks linked nodes for silence while gating is enabled
+
+      private:
+        interner strings; // Backs the properties of every cached global, has to outlive them
 
       private:
-        std::unordered_map<std::uint32_t, pw::node_info> nodes;
-        std::unordered_map<std::uint32_t, pw::port_info> ports;
-        std::unordered_map<std::uint32_t, pw::link_info> links;
+        std::unordered_map<std::uint32_t, node_entry> nodes;
+        std::unordered_map<std::uint32_t, link_entry> links;
+
+      private:
+        adjacency edges;
+        property_index index{strings, {"node.name", "object.serial", "application.process.binary"}};
+
+        std::unordered_map<std::uint32_t, std::uint32_t> ports;                            // port -> node
+        std::unordered_map<std::uint32_t, std::map<std::uint32_t, port_entry>> node_ports; // node -> ports
+
+      private:
+        std::unordered_map<std::uint32_t, bool> decisions; // node -> cached result of `should_link`
+
+      private:
+        bool flushing{false};
+        std::uint64_t flushes{0};                  // Batches evaluated so far, tells a late sync apart from a current one
+        std::unordered_set<std::uint32_t> pending; // Nodes to evaluate once the current burst settles
+        spa_source *flush_timer{nullptr};          // Evaluates the current batch should the sync take too long
 
       private:
         std::jthread worker;
@@ -90,22 +227,47 @@ namespace vencord
         void cleanup(clean);
 
       private:
-        coco::task<void> create_mic(bool);
-        coco::task<void> mute(pw::node_info, bool);
-        coco::task<void> redirect(std::optional<pw::node_info> = {});
+        coco::task<void> create_mic(bool, audio_format);
+        coco::task<void> create_source(bool, audio_format);
+        coco::task<void> create_mixer(bool, audio_format);
+        coco::task<void> create_meter();
+        coco::task<void> create_capture(std::uint32_t);
+        coco::task<void> mute(std::uint32_t, bool);
+        coco::task<void> redirect(std::optional<std::uint32_t> = {});
+        void force_quantum(std::optional<std::uint32_t>);
+        coco::task<void> sync(); // Like core->sync(), but records the round-trip
+        void publish();
+        coco::task<std::optional<spa_latency_info>> upstream(std::vector<std::uint32_t>);
 
       private:
-        bool should_link(const pw::node_info &);
-        void link(const pw::node_info &, const pw::node_info &);
+        bool should_link(std::uint32_t, const node_entry &);
+        bool decide(std::uint32_t, const node_entry &);
+        void invalidate(std::uint32_t);
+        void link(std::uint32_t, std::uint32_t);
+        void attach(std::uint32_t, mix_node &, tap virt_link::*);
+        coco::stray feed(std::uint32_t, std::uint32_t, tap virt_link::*);
+        coco::stray connect(std::uint32_t, tap virt_link::*, port_pairs);
+        port_pairs route(std::uint32_t, std::uint32_t, std::string_view = {}, mapping = mapping::exact);
+        std::string report(std::uint32_t, std::uint32_t);
+        coco::stray pause(std::uint32_t, bool); // Removes or restores the route of a linked node, keeps its meter tap
+        void update_gates();
+        void release_profiler();
 
       private:
-        std::map<std::uint32_t, pw::port_info> ports_of(const pw::node_info &);
-        std::map<std::uint32_t, pw::link_info> links_of(const pw::node_info &);
+        const std::map<std::uint32_t, port_entry> &ports_of(std::uint32_t);
+        audio_format format_of(std::uint32_t, pw::port_direction);
+        audio_format resolve(audio_format);
+        std::optional<std::uint32_t> find_matching(const matcher &, const std::vector<node> &);
 
       private:
         template <typename T>
         coco::stray handle(T);
 
+      private:
+        void schedule(std::uint32_t);
+        coco::stray flush();
+        coco::stray evaluate();
+
       private:
         void add_global(pw::global);
         void del_global(std::uint32_t);
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "patchbay.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+struct pw_registry;
+
+namespace vencord
+{
+    // Keeps rolling windows of the profiler data for tracked nodes, all calls have to be made from the pipewire thread
+    struct profiler
+    {
+        struct impl;
+
+      private:
+        std::unique_ptr<impl> m_impl;
+
+      private:
+        profiler();
+
+      public:
+        ~profiler();
+
+      public:
+        void track(std::uint32_t id, std::string name);
+        void untrack(std::uint32_t id);
+
+      public:
+        [[nodiscard]] std::vector<load> stats() const;
+
+      public:
+        [[nodiscard]] static std::unique_ptr<profiler> bind(pw_registry *, std::uint32_t id);
+    };
+} // namespace vencord
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "interner.hpp"
+
+#include <vector>
+#include <utility>
+#include <string_view>
+
+namespace vencord
+{
+    struct properties
+    {
+        using entry = std::pair<std::string_view, std::string_view>;
+
+      private:
+        interner *m_strings{nullptr};
+        std::vector<entry> m_entries; // Sorted by key, views point into `m_strings`
+
+      public:
+        properties() = default;
+
+      public:
+        template <typename T>
+        properties(interner &, const T &props);
+
+      public:
+        properties(const properties &);
+        properties(properties &&) noexcept;
+
+      public:
+        properties &operator=(properties);
+
+      public:
+        ~properties();
+
+      public:
+        [[nodiscard]] bool contains(std::string_view key) const;
+        [[nodiscard]] std::string_view at(std::string_view key) const;
+
+      public:
+        [[nodiscard]] std::string_view operator[](std::string_view key) const; // Empty if absent
+
+      public:
+        [[nodiscard]] auto begin() const
+        {
+            return m_entries.begin();
+        }
+
+        [[nodiscard]] auto end() const
+        {
+            return m_entries.end();
+        }
+    };
+} // namespace vencord
+
+#include "properties.inl"
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "properties.hpp"
+
+#include <algorithm>
+
+namespace vencord
+{
+    template <typename T>
+    properties::properties(interner &strings, const T &props) : m_strings(&strings)
+    {
+        for (const auto &[key, value] : props)
+        {
+            m_entries.emplace_back(strings.intern(key), strings.intern(value));
+        }
+
+        std::ranges::sort(m_entries, {}, &entry::first);
+        m_entries.shrink_to_fit();
+    }
+} // namespace vencord
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+namespace vencord
+{
+    // Buckets are fixed so that observing a value is a single relaxed increment
+    struct histogram
+    {
+        static constexpr auto bounds = std::array{1e-6, 4e-6, 16e-6, 64e-6, 256e-6, 1e-3, 4e-3, 16e-3, 64e-3, 256e-3, 1.0};
+
+      private:
+        std::array<std::atomic<std::uint64_t>, bounds.size() + 1> m_buckets{};
+        std::atomic<std::uint64_t> m_sum{0}; // In nanoseconds
+
+      public:
+        void observe(std::chrono::nanoseconds);
+        void render(std::string &, std::string_view name, std::string_view help) const;
+    };
+
+    // Holds one unit of a gauge for as long as it lives, its release can additionally be counted
+    struct tally
+    {
+      private:
+        std::atomic<std::uint64_t> *m_gauge{nullptr};
+        std::atomic<std::uint64_t> *m_released{nullptr};
+        bool m_held{false};
+
+      public:
+        tally() = default;
+        tally(std::atomic<std::uint64_t> *gauge, std::atomic<std::uint64_t> *released = nullptr);
+
+      public:
+        tally(tally &&) noexcept;
+        tally &operator=(tally &&) noexcept;
+
+      public:
+        ~tally();
+
+      public:
+        explicit operator bool() const;
+
+      private:
+        void release();
+    };
+
+    // Written from the pipewire thread and rendered from any thread without taking a lock
+    struct statistics
+    {
+        enum class event : std::uint8_t
+        {
+            node,
+            port,
+            link,
+            metadata,
+            removed,
+        };
+
+      public:
+        std::atomic<std::uint64_t> nodes{0};
+        std::atomic<std::uint64_t> ports{0};
+        std::atomic<std::uint64_t> links{0};
+        std::atomic<std::uint64_t> virt_links{0};
+        std::atomic<std::uint64_t> active{0};
+        std::atomic<std::uint64_t> gated{0};
+
+      public:
+        std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(event::removed) + 1> events{};
+        std::atomic<std::uint64_t> loopbacks_created{0};
+        std::atomic<std::uint64_t> loopbacks_destroyed{0};
+
+      public:
+        std::atomic<std::uint64_t> scheduled{0}; // Evaluations requested by registry events
+        std::atomic<std::uint64_t> evaluated{0}; // Evaluations actually performed
+        std::atomic<std::uint64_t> dropped{0};   // Nodes removed before their batch was evaluated
+        std::atomic<std::uint64_t> deadlines{0}; // Batches evaluated before their sync round-trip completed
+
+      public:
+        std::atomic<std::uint64_t> evaluations{0};
+        std::atomic<std::uint64_t> acceptances{0};
+
+      public:
+        histogram should_link;
+        histogram list;
+        histogram sync;
+
+      public:
+        void count(event);
+        [[nodiscard]] std::string render() const;
+    };
+} // namespace vencord
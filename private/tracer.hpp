@@ -0,0 +1,50 @@
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace vencord
+{
+    // Spans are recorded into a fixed-size ring per thread, so recording never takes a lock
+    struct tracer
+    {
+        struct ring;
+
+      private:
+        std::mutex m_mutex; // Only guards the list of rings, which grows once per recording thread
+        std::vector<std::shared_ptr<ring>> m_rings;
+
+      private:
+        tracer() = default;
+
+      public:
+        void record(const char *name, std::uint64_t start, std::uint64_t end);
+
+      public:
+        [[nodiscard]] std::string dump(); // Chrome trace / Perfetto JSON of every recorded span
+
+      public:
+        [[nodiscard]] static std::uint64_t now(); // Nanoseconds on a monotonic clock
+        [[nodiscard]] static tracer &get();
+    };
+
+    // Records the lifetime of the enclosing scope, the name has to outlive the tracer
+    struct span
+    {
+        const char *name;
+        std::uint64_t start;
+
+      public:
+        explicit span(const char *name);
+
+      public:
+        span(const span &)            = delete;
+        span &operator=(const span &) = delete;
+
+      public:
+        ~span();
+    };
+} // namespace vencord
@@ -82,6 +82,75 @@ int main(int argc, char **args)
                     response.status = 418;
                 });
 
+    server.Post("/capture/start",
+                [](const auto &req, auto &response)
+                {
+                    const auto seconds = glz::read_json<std::uint32_t>(req.body);
+
+                    patchbay::get().start_capture(seconds.value_or(30));
+                    response.status = 200;
+                });
+
+    server.Get("/capture/stop",
+               [](const auto &, auto &response)
+               {
+                   patchbay::get().stop_capture();
+                   response.status = 200;
+               });
+
+    server.Get("/levels",
+               [](const auto &, auto &response)
+               {
+                   if (const auto data = glz::write_json(patchbay::get().levels()); data.has_value())
+                   {
+                       response.set_content(*data, "application/json");
+                       response.status = 200;
+                       return;
+                   }
+
+                   response.status = 500;
+               });
+
+    server.Get("/latency",
+               [](const auto &, auto &response)
+               {
+                   if (const auto data = glz::write_json(patchbay::get().measure()); data.has_value())
+                   {
+                       response.set_content(*data, "application/json");
+                       response.status = 200;
+                       return;
+                   }
+
+                   response.status = 500;
+               });
+
+    server.Get("/telemetry",
+               [](const auto &, auto &response)
+               {
+                   if (const auto data = glz::write_json(patchbay::get().telemetry()); data.has_value())
+                   {
+                       response.set_content(*data, "application/json");
+                       response.status = 200;
+                       return;
+                   }
+
+                   response.status = 500;
+               });
+
+    server.Get("/metrics",
+               [](const auto &, auto &response)
+               {
+                   response.set_content(patchbay::get().metrics(), "text/plain; version=0.0.4");
+                   response.status = 200;
+               });
+
+    server.Get("/trace",
+               [](const auto &, auto &response)
+               {
+                   response.set_content(patchbay::get().spans(), "application/json");
+                   response.status = 200;
+               });
+
     server.Get("/has-pipewire-pulse",
                [](const auto &, auto &response)
                {
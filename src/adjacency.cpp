@@ -0,0 +1,73 @@
+#include "adjacency.hpp"
+
+namespace vencord
+{
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static const adjacency::peers &peers_of(const std::unordered_map<std::uint32_t, adjacency::peers> &map,
+                                            std::uint32_t id)
+    {
+        static const auto empty = adjacency::peers{};
+
+        if (const auto it = map.find(id); it != map.end())
+        {
+            return it->second;
+        }
+
+        return empty;
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static bool unref(std::unordered_map<std::uint32_t, adjacency::peers> &map, std::uint32_t id, std::uint32_t peer)
+    {
+        const auto node = map.find(id);
+
+        if (node == map.end())
+        {
+            return false;
+        }
+
+        auto &peers     = node->second;
+        const auto link = peers.find(peer);
+        auto removed    = false;
+
+        if (link != peers.end() && --link->second == 0)
+        {
+            peers.erase(link);
+            removed = true;
+        }
+
+        if (peers.empty())
+        {
+            map.erase(node);
+        }
+
+        return removed;
+    }
+
+    bool adjacency::add(std::uint32_t from, std::uint32_t to)
+    {
+        ++m_inputs[to][from];
+        return ++m_outputs[from][to] == 1;
+    }
+
+    bool adjacency::remove(std::uint32_t from, std::uint32_t to)
+    {
+        unref(m_inputs, to, from);
+        return unref(m_outputs, from, to);
+    }
+
+    bool adjacency::feeds(std::uint32_t from, std::uint32_t to) const
+    {
+        return outputs(from).contains(to);
+    }
+
+    const adjacency::peers &adjacency::outputs(std::uint32_t id) const
+    {
+        return peers_of(m_outputs, id);
+    }
+
+    const adjacency::peers &adjacency::inputs(std::uint32_t id) const
+    {
+        return peers_of(m_inputs, id);
+    }
+} // namespace vencord
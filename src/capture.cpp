@@ -0,0 +1,10 @@
+#include "capture.hpp"
+#include "logger.hpp"
+
+namespace vencord
+{
+    std::filesystem::path capture_file::path()
+    {
+        return logger::directory() / "venmic.capture";
+    }
+} // namespace vencord
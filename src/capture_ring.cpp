@@ -0,0 +1,138 @@
+#include "capture_ring.hpp"
+#include "logger.hpp"
+
+#include <new>
+#include <atomic>
+#include <thread>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace vencord
+{
+    namespace fs = std::filesystem;
+    using enum logger::level;
+
+    struct capture_ring::impl
+    {
+        void *memory{nullptr};
+        std::size_t size{0};
+
+      public:
+        capture_file::header *head{nullptr};
+        float *samples{nullptr};
+
+      public:
+        std::jthread populate; // Faults the mapping in while the capture already runs
+
+      public:
+        ~impl();
+    };
+
+    capture_ring::impl::~impl()
+    {
+        if (!memory)
+        {
+            return;
+        }
+
+        if (populate.joinable())
+        {
+            populate.join();
+        }
+
+        ::munmap(memory, size);
+    }
+
+    capture_ring::capture_ring() : m_impl(std::make_unique<impl>()) {}
+
+    capture_ring::~capture_ring() = default;
+
+    void capture_ring::write(std::span<const std::span<const float>> channels, std::uint32_t rate)
+    {
+        auto *const head = m_impl->head;
+
+        if (channels.size() != head->channels || channels.empty())
+        {
+            return;
+        }
+
+        auto position        = std::atomic_ref{head->head};
+        const auto start     = position.load(std::memory_order_relaxed);
+        const auto frames    = channels.front().size();
+        const auto &capacity = head->capacity;
+
+        for (auto frame = 0uz; frames > frame; ++frame)
+        {
+            auto *const dst = m_impl->samples + (((start + frame) % capacity) * channels.size());
+
+            for (auto channel = 0uz; channels.size() > channel; ++channel)
+            {
+                dst[channel] = channels[channel][frame];
+            }
+        }
+
+        std::atomic_ref{head->rate}.store(rate, std::memory_order_relaxed);
+        position.store(start + frames, std::memory_order_release);
+    }
+
+    std::shared_ptr<capture_ring> capture_ring::create(const fs::path &file, std::uint32_t channels, std::uint32_t frames)
+    {
+        auto ec = std::error_code{};
+        fs::create_directories(file.parent_path(), ec);
+
+        const auto size = sizeof(capture_file::header) + (std::size_t{frames} * channels * sizeof(float));
+        const auto fd   = ::open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644); // NOLINT(*-vararg)
+
+        if (fd < 0)
+        {
+            logger::get()(warn, "[capture_ring] (create) failed to open {}: {}", file.string(), std::strerror(errno));
+            return nullptr;
+        }
+
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            logger::get()(warn, "[capture_ring] (create) failed to resize {}: {}", file.string(), std::strerror(errno));
+            ::close(fd);
+            return nullptr;
+        }
+
+        // Populating the whole mapping here would stall the pipewire thread for large rings, see below
+        auto *const memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (memory == MAP_FAILED)
+        {
+            logger::get()(warn, "[capture_ring] (create) failed to map {}: {}", file.string(), std::strerror(errno));
+            return nullptr;
+        }
+
+        auto rtn = std::shared_ptr<capture_ring>(new capture_ring);
+
+        rtn->m_impl->memory = memory;
+        rtn->m_impl->size   = size;
+
+        rtn->m_impl->head = new (memory) capture_file::header{
+            .magic    = capture_file::magic,
+            .version  = capture_file::version,
+            .channels = channels,
+            .capacity = frames,
+            .rate     = 0,
+            .head     = 0,
+        };
+
+        rtn->m_impl->samples = reinterpret_cast<float *>(static_cast<char *>(memory) + sizeof(capture_file::header));
+
+#ifdef MADV_POPULATE_WRITE
+        // Keeps page faults out of the processing thread, populating leaves the contents untouched so it may race the writer
+        rtn->m_impl->populate = std::jthread{[memory, size] { ::madvise(memory, size, MADV_POPULATE_WRITE); }};
+#endif
+
+        logger::get()(debug, "[capture_ring] (create) capturing {} frame(s) into {}", frames, file.string());
+
+        return rtn;
+    }
+} // namespace vencord
@@ -0,0 +1,50 @@
+#include "index.hpp"
+
+namespace vencord
+{
+    property_index::property_index(interner &strings, std::initializer_list<std::string_view> keys)
+        : m_strings(&strings)
+    {
+        for (const auto &key : keys)
+        {
+            m_index.emplace(key, value_map{});
+        }
+    }
+
+    property_index::~property_index()
+    {
+        for (const auto &[key, values] : m_index)
+        {
+            for (const auto &[value, ids] : values)
+            {
+                m_strings->release(value);
+            }
+        }
+    }
+
+    bool property_index::indexed(std::string_view key) const
+    {
+        return m_index.contains(key);
+    }
+
+    const property_index::ids &property_index::find(std::string_view key, std::string_view value) const
+    {
+        static const auto empty = ids{};
+
+        const auto values = m_index.find(key);
+
+        if (values == m_index.end())
+        {
+            return empty;
+        }
+
+        const auto it = values->second.find(value);
+
+        if (it == values->second.end())
+        {
+            return empty;
+        }
+
+        return it->second;
+    }
+} // namespace vencord
@@ -0,0 +1,98 @@
+#include "interner.hpp"
+
+#include <iterator>
+#include <algorithm>
+
+namespace vencord
+{
+    std::size_t string_hash::operator()(std::string_view value) const
+    {
+        return std::hash<std::string_view>{}(value);
+    }
+
+    char *interner::allocate(std::size_t granules)
+    {
+        if (auto it = m_free.find(granules); it != m_free.end() && !it->second.empty())
+        {
+            auto *const rtn = it->second.back();
+            it->second.pop_back();
+
+            return rtn;
+        }
+
+        const auto size = granules * granule;
+
+        if (size > block_size)
+        {
+            // Oversized strings get a block of their own, which is placed before the block that is currently filled
+            auto block      = std::make_unique_for_overwrite<char[]>(size);
+            auto *const rtn = block.get();
+
+            m_blocks.emplace(m_blocks.empty() ? m_blocks.end() : std::prev(m_blocks.end()), std::move(block));
+            m_capacity += size;
+
+            return rtn;
+        }
+
+        if (block_size - m_used < size)
+        {
+            m_blocks.emplace_back(std::make_unique_for_overwrite<char[]>(block_size));
+            m_capacity += block_size;
+            m_used = 0;
+        }
+
+        auto *const rtn = m_blocks.back().get() + m_used;
+        m_used += size;
+
+        return rtn;
+    }
+
+    void interner::deallocate(char *storage, std::size_t granules)
+    {
+        m_free[granules].emplace_back(storage);
+    }
+
+    std::string_view interner::intern(std::string_view value)
+    {
+        if (value.empty())
+        {
+            return {};
+        }
+
+        if (const auto it = m_strings.find(value); it != m_strings.end())
+        {
+            ++it->second;
+            return it->first;
+        }
+
+        auto *const storage = allocate((value.size() + granule - 1) / granule);
+        std::ranges::copy(value, storage);
+
+        return m_strings.emplace(std::string_view{storage, value.size()}, 1).first->first;
+    }
+
+    void interner::release(std::string_view value)
+    {
+        const auto it = m_strings.find(value);
+
+        if (it == m_strings.end() || --it->second > 0)
+        {
+            return;
+        }
+
+        const auto stored = it->first;
+        m_strings.erase(it);
+
+        deallocate(const_cast<char *>(stored.data()), (stored.size() + granule - 1) / granule);
+    }
+
+    std::size_t interner::size() const
+    {
+        return m_strings.size();
+    }
+
+    std::size_t interner::capacity() const
+    {
+        return m_capacity;
+    }
+} // namespace vencord
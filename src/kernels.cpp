@@ -0,0 +1,280 @@
+#include "kernels.hpp"
+
+#include <cmath>
+#include <array>
+#include <atomic>
+#include <ranges>
+#include <vector>
+#include <numeric>
+#include <cstddef>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VENMIC_X86
+#include <immintrin.h>
+#endif
+
+namespace vencord::kernels
+{
+    struct implementation
+    {
+        const char *name;
+
+      public:
+        void (*mix)(float *, const float *, std::size_t, float);
+        void (*clip)(float *, std::size_t);
+        void (*measure)(const float *, std::size_t, float &, float &);
+    };
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static void mix_scalar(float *dst, const float *src, std::size_t size, float gain)
+    {
+        for (auto i = 0uz; size > i; ++i)
+        {
+            dst[i] += src[i] * gain;
+        }
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static void clip_scalar(float *dst, std::size_t size)
+    {
+        for (auto i = 0uz; size > i; ++i)
+        {
+            dst[i] = std::clamp(dst[i], -1.0f, 1.0f);
+        }
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static void measure_scalar(const float *src, std::size_t size, float &peak, float &squares)
+    {
+        for (auto i = 0uz; size > i; ++i)
+        {
+            peak = std::max(peak, std::abs(src[i]));
+            squares += src[i] * src[i];
+        }
+    }
+
+#ifdef VENMIC_X86
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    __attribute__((target("sse"))) static void mix_sse(float *dst, const float *src, std::size_t size, float gain)
+    {
+        const auto factor = _mm_set1_ps(gain);
+        auto i            = 0uz;
+
+        for (; size >= i + 4; i += 4)
+        {
+            const auto sum = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), factor));
+            _mm_storeu_ps(dst + i, sum);
+        }
+
+        mix_scalar(dst + i, src + i, size - i, gain);
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    __attribute__((target("sse"))) static void clip_sse(float *dst, std::size_t size)
+    {
+        const auto lower = _mm_set1_ps(-1.0f);
+        const auto upper = _mm_set1_ps(1.0f);
+        auto i           = 0uz;
+
+        for (; size >= i + 4; i += 4)
+        {
+            _mm_storeu_ps(dst + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(dst + i), lower), upper));
+        }
+
+        clip_scalar(dst + i, size - i);
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    __attribute__((target("sse"))) static void measure_sse(const float *src, std::size_t size, float &peak, float &squares)
+    {
+        const auto sign = _mm_set1_ps(-0.0f);
+        auto maximum    = _mm_setzero_ps();
+        auto sum        = _mm_setzero_ps();
+        auto i          = 0uz;
+
+        for (; size >= i + 4; i += 4)
+        {
+            const auto value = _mm_loadu_ps(src + i);
+
+            maximum = _mm_max_ps(maximum, _mm_andnot_ps(sign, value));
+            sum     = _mm_add_ps(sum, _mm_mul_ps(value, value));
+        }
+
+        alignas(16) auto maxima = std::array<float, 4>{};
+        alignas(16) auto sums   = std::array<float, 4>{};
+
+        _mm_store_ps(maxima.data(), maximum);
+        _mm_store_ps(sums.data(), sum);
+
+        peak    = std::max(peak, std::ranges::max(maxima));
+        squares = std::accumulate(sums.begin(), sums.end(), squares);
+
+        measure_scalar(src + i, size - i, peak, squares);
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    __attribute__((target("avx2,fma"))) static void mix_avx2(float *dst, const float *src, std::size_t size, float gain)
+    {
+        const auto factor = _mm256_set1_ps(gain);
+        auto i            = 0uz;
+
+        for (; size >= i + 8; i += 8)
+        {
+            _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i), factor, _mm256_loadu_ps(dst + i)));
+        }
+
+        mix_scalar(dst + i, src + i, size - i, gain);
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    __attribute__((target("avx2"))) static void clip_avx2(float *dst, std::size_t size)
+    {
+        const auto lower = _mm256_set1_ps(-1.0f);
+        const auto upper = _mm256_set1_ps(1.0f);
+        auto i           = 0uz;
+
+        for (; size >= i + 8; i += 8)
+        {
+            _mm256_storeu_ps(dst + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(dst + i), lower), upper));
+        }
+
+        clip_scalar(dst + i, size - i);
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    __attribute__((target("avx2,fma"))) static void measure_avx2(const float *src, std::size_t size, float &peak,
+                                                                 float &squares)
+    {
+        const auto sign = _mm256_set1_ps(-0.0f);
+        auto maximum    = _mm256_setzero_ps();
+        auto sum        = _mm256_setzero_ps();
+        auto i          = 0uz;
+
+        for (; size >= i + 8; i += 8)
+        {
+            const auto value = _mm256_loadu_ps(src + i);
+
+            maximum = _mm256_max_ps(maximum, _mm256_andnot_ps(sign, value));
+            sum     = _mm256_fmadd_ps(value, value, sum);
+        }
+
+        alignas(32) auto maxima = std::array<float, 8>{};
+        alignas(32) auto sums   = std::array<float, 8>{};
+
+        _mm256_store_ps(maxima.data(), maximum);
+        _mm256_store_ps(sums.data(), sum);
+
+        peak    = std::max(peak, std::ranges::max(maxima));
+        squares = std::accumulate(sums.begin(), sums.end(), squares);
+
+        measure_scalar(src + i, size - i, peak, squares);
+    }
+#endif
+
+    // Ordered from slowest to fastest, only the ones the current CPU supports may be used
+    static constexpr auto implementations = std::array{
+        implementation{.name = "scalar", .mix = mix_scalar, .clip = clip_scalar, .measure = measure_scalar},
+#ifdef VENMIC_X86
+        implementation{.name = "sse", .mix = mix_sse, .clip = clip_sse, .measure = measure_sse},
+        implementation{.name = "avx2", .mix = mix_avx2, .clip = clip_avx2, .measure = measure_avx2},
+#endif
+    };
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static bool supported(const implementation &item)
+    {
+        const auto name = std::string_view{item.name};
+
+#ifdef VENMIC_X86
+        __builtin_cpu_init();
+
+        if (name == "sse")
+        {
+            return __builtin_cpu_supports("sse");
+        }
+
+        if (name == "avx2")
+        {
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        }
+#endif
+
+        return name == "scalar";
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static const implementation *fastest()
+    {
+        for (const auto &item : implementations | std::views::reverse)
+        {
+            if (supported(item))
+            {
+                return &item;
+            }
+        }
+
+        return &implementations.front();
+    }
+
+    // Resolved while the library is loaded, so the processing thread never has to initialize anything
+    static std::atomic<const implementation *> active{fastest()}; // NOLINT(*-anonymous-namespace)
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static const implementation &selected()
+    {
+        return *active.load(std::memory_order_relaxed);
+    }
+
+    void mix(std::span<float> dst, std::span<const float> src, float gain)
+    {
+        selected().mix(dst.data(), src.data(), std::min(dst.size(), src.size()), gain);
+    }
+
+    void clip(std::span<float> dst)
+    {
+        selected().clip(dst.data(), dst.size());
+    }
+
+    measurement measure(std::span<const float> src)
+    {
+        auto peak    = 0.0f;
+        auto squares = 0.0f;
+
+        if (src.empty())
+        {
+            return {};
+        }
+
+        selected().measure(src.data(), src.size(), peak, squares);
+
+        return {.peak = peak, .rms = std::sqrt(squares / static_cast<float>(src.size()))};
+    }
+
+    const char *name()
+    {
+        return selected().name;
+    }
+
+    std::vector<const char *> available()
+    {
+        return implementations                              //
+               | std::views::filter(supported)              //
+               | std::views::transform(&implementation::name) //
+               | std::ranges::to<std::vector>();
+    }
+
+    bool use(std::string_view name)
+    {
+        const auto it = std::ranges::find_if(implementations, [name](const auto &item) { return item.name == name; });
+
+        if (it == implementations.end() || !supported(*it))
+        {
+            return false;
+        }
+
+        active.store(&*it, std::memory_order_relaxed);
+
+        return true;
+    }
+} // namespace vencord::kernels
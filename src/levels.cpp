@@ -0,0 +1,105 @@
+#include "levels.hpp"
+
+#include <algorithm>
+
+namespace vencord
+{
+    level_table::slot *level_table::acquire(std::uint32_t node)
+    {
+        const auto is_unused = [](const auto &item)
+        {
+            return item.node.load(std::memory_order_relaxed) == unused;
+        };
+
+        const auto it = std::ranges::find_if(m_slots, is_unused);
+
+        if (it == m_slots.end())
+        {
+            return nullptr;
+        }
+
+        for (auto channel = 0uz; it->peak.size() > channel; ++channel)
+        {
+            it->peak[channel].store(0.0f, std::memory_order_relaxed);
+            it->rms[channel].store(0.0f, std::memory_order_relaxed);
+            it->held[channel].store(0.0f, std::memory_order_relaxed);
+        }
+
+        it->node.store(node, std::memory_order_release);
+
+        return &*it;
+    }
+
+    void level_table::release(slot *item)
+    {
+        if (!item)
+        {
+            return;
+        }
+
+        item->node.store(unused, std::memory_order_release);
+    }
+
+    std::vector<level> level_table::read() const
+    {
+        auto rtn = std::vector<level>{};
+
+        for (const auto &item : m_slots)
+        {
+            const auto node = item.node.load(std::memory_order_acquire);
+
+            if (node == unused)
+            {
+                continue;
+            }
+
+            auto current = level{.node = node};
+
+            for (auto channel = 0uz; item.peak.size() > channel; ++channel)
+            {
+                current.peak[channel] = item.peak[channel].load(std::memory_order_relaxed);
+                current.rms[channel]  = item.rms[channel].load(std::memory_order_relaxed);
+            }
+
+            rtn.emplace_back(current);
+        }
+
+        return rtn;
+    }
+
+    std::vector<level> level_table::drain()
+    {
+        auto rtn = std::vector<level>{};
+
+        for (auto &item : m_slots)
+        {
+            const auto node = item.node.load(std::memory_order_acquire);
+
+            if (node == unused)
+            {
+                continue;
+            }
+
+            auto current = level{.node = node};
+
+            for (auto channel = 0uz; item.held.size() > channel; ++channel)
+            {
+                current.peak[channel] = item.held[channel].exchange(0.0f, std::memory_order_relaxed);
+                current.rms[channel]  = item.rms[channel].load(std::memory_order_relaxed);
+            }
+
+            rtn.emplace_back(current);
+        }
+
+        return rtn;
+    }
+
+    void level_table::hold(std::atomic<float> &held, float peak)
+    {
+        auto current = held.load(std::memory_order_relaxed);
+
+        while (peak > current && !held.compare_exchange_weak(current, peak, std::memory_order_relaxed))
+        {
+        }
+    }
+} // namespace vencord
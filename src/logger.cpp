@@ -1,21 +1,30 @@
 #include "logger.hpp"
 
+#include <chrono>
+#include <algorithm>
 #include <filesystem>
 
 #include <spdlog/spdlog.h>
+#include <spdlog/async_logger.h>
+#include <spdlog/details/thread_pool.h>
+
 #include <spdlog/sinks/ansicolor_sink.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
 namespace vencord
 {
     namespace fs = std::filesystem;
+    using namespace std::chrono_literals;
+
+    static constexpr auto queue_size = 8192uz; // Messages buffered for the file sink, the oldest are dropped on overflow
 
     struct logger::impl
     {
-        std::unique_ptr<spdlog::logger> logger;
+        std::shared_ptr<spdlog::details::thread_pool> pool;
+        std::shared_ptr<spdlog::logger> logger;
     };
 
-    static fs::path log_directory() // NOLINT(*-anonymous-namespace)
+    fs::path logger::directory()
     {
         auto rtn = fs::temp_directory_path();
 
@@ -38,23 +47,22 @@ namespace vencord
     {
         namespace sinks = spdlog::sinks;
 
-        m_impl->logger = std::make_unique<spdlog::logger>("venmic");
-        m_impl->logger->set_level(spdlog::level::trace);
-        m_impl->logger->flush_on(spdlog::level::trace);
-
         const auto stdout_sink = std::make_shared<sinks::ansicolor_stdout_sink_mt>();
         const auto *level      = std::getenv("VENMIC_LOG_LEVEL"); // NOLINT(*-mt-unsafe)
         const auto log_level   = level ? static_cast<spdlog::level::level_enum>(level[0] - '0') : spdlog::level::info;
 
         stdout_sink->set_level(log_level);
-        m_impl->logger->sinks().emplace_back(stdout_sink);
 
         if (!std::getenv("VENMIC_ENABLE_LOG")) // NOLINT(*-mt-unsafe)
         {
+            m_threshold    = static_cast<logger::level>(std::clamp<int>(log_level, 0, 255));
+            m_impl->logger = std::make_shared<spdlog::logger>("venmic", stdout_sink);
+            m_impl->logger->set_level(log_level);
+
             return;
         }
 
-        const auto directory     = log_directory();
+        const auto directory     = logger::directory();
         [[maybe_unused]] auto ec = std::error_code{};
 
         if (!fs::exists(directory, ec))
@@ -63,9 +71,24 @@ namespace vencord
         }
 
         const auto file_sink = std::make_shared<sinks::basic_file_sink_mt>((directory / "venmic.log").string());
-
         file_sink->set_level(spdlog::level::trace);
-        m_impl->logger->sinks().emplace_back(file_sink);
+
+        // Formatting and writing happens on a background thread, so the caller only pays for enqueuing the message.
+        // The file is flushed in batches, or immediately for warnings and errors.
+
+        const auto all_sinks = std::vector<spdlog::sink_ptr>{stdout_sink, file_sink};
+
+        m_threshold    = logger::level::trace;
+        m_impl->pool   = std::make_shared<spdlog::details::thread_pool>(queue_size, 1);
+        m_impl->logger = std::make_shared<spdlog::async_logger>("venmic", all_sinks.begin(), all_sinks.end(), m_impl->pool,
+                                                                spdlog::async_overflow_policy::overrun_oldest);
+
+        m_impl->logger->set_level(spdlog::level::trace);
+        m_impl->logger->flush_on(spdlog::level::warn);
+
+        // spdlog only flushes registered loggers periodically
+        spdlog::register_logger(m_impl->logger);
+        spdlog::flush_every(1s);
     }
 
     void logger::log(logger::level level, std::string_view message) const
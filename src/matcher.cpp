@@ -0,0 +1,192 @@
+#include "matcher.hpp"
+#include "logger.hpp"
+
+#include <array>
+
+namespace vencord
+{
+    using enum logger::level;
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static bool glob(std::string_view pattern, std::string_view value)
+    {
+        auto p = 0uz;
+        auto v = 0uz;
+
+        auto star  = std::string_view::npos;
+        auto retry = 0uz;
+
+        while (v < value.size())
+        {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == value[v]))
+            {
+                ++p;
+                ++v;
+            }
+            else if (p < pattern.size() && pattern[p] == '*')
+            {
+                star  = p++;
+                retry = v;
+            }
+            else if (star != std::string_view::npos)
+            {
+                p = star + 1;
+                v = ++retry;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while (p < pattern.size() && pattern[p] == '*')
+        {
+            ++p;
+        }
+
+        return p == pattern.size();
+    }
+
+    bool pattern::matches(std::string_view subject) const
+    {
+        switch (type)
+        {
+            using enum pattern::kind;
+
+        case prefix:
+            return subject.starts_with(value);
+        case glob:
+            return vencord::glob(value, subject);
+        case regex:
+            return std::regex_match(subject.begin(), subject.end(), *expression);
+        }
+
+        return false;
+    }
+
+    std::optional<pattern> pattern::parse(std::string &value)
+    {
+        using enum pattern::kind;
+
+        static constexpr auto exact    = std::string_view{"exact:"};
+        static constexpr auto prefixes = std::array{
+            std::pair{std::string_view{"prefix:"}, prefix},
+            std::pair{std::string_view{"glob:"}, glob},
+            std::pair{std::string_view{"regex:"}, regex},
+        };
+
+        if (value.starts_with(exact))
+        {
+            value.erase(0, exact.size());
+            return std::nullopt;
+        }
+
+        const auto match = std::ranges::find_if(prefixes, [&](const auto &item) { return value.starts_with(item.first); });
+
+        if (match == prefixes.end())
+        {
+            return std::nullopt;
+        }
+
+        auto rtn = pattern{
+            .type  = match->second,
+            .value = value.substr(match->first.size()),
+        };
+
+        if (rtn.type == glob && !rtn.value.contains('*') && !rtn.value.contains('?'))
+        {
+            value = std::move(rtn.value);
+            return std::nullopt;
+        }
+
+        if (rtn.type == glob && rtn.value.find_first_of("*?") == rtn.value.size() - 1 && rtn.value.back() == '*')
+        {
+            rtn.type = prefix;
+            rtn.value.pop_back();
+        }
+
+        if (rtn.type == regex && rtn.value.size() > max_expression)
+        {
+            throw std::regex_error{std::regex_constants::error_complexity};
+        }
+
+        if (rtn.type == regex)
+        {
+            rtn.expression.emplace(rtn.value, std::regex::ECMAScript | std::regex::optimize);
+        }
+
+        return rtn;
+    }
+
+    matcher::matcher(const std::vector<node> &targets)
+    {
+        auto keys = string_map<std::size_t>{}; // key -> group
+
+        for (const auto &target : targets)
+        {
+            if (target.empty())
+            {
+                m_always = true;
+                continue;
+            }
+
+            auto conditions = std::vector<condition>{};
+            conditions.reserve(target.size());
+
+            const auto compile = [&conditions](const auto &item)
+            {
+                const auto &[key, raw] = item;
+                auto value             = raw;
+
+                try
+                {
+                    auto parsed = pattern::parse(value);
+                    conditions.emplace_back(key, std::move(value), std::move(parsed));
+                }
+                catch (const std::regex_error &e)
+                {
+                    logger::get()(warn, "[matcher] ignoring invalid pattern \"{}\" for {}: {}", raw, key, e.what());
+                    return false;
+                }
+
+                return true;
+            };
+
+            if (!std::ranges::all_of(target, compile))
+            {
+                // A single unsatisfiable key means the rule as a whole can never match
+                continue;
+            }
+
+            const auto rule = static_cast<std::uint32_t>(m_rests.size());
+            auto &first     = conditions.front();
+
+            auto [it, inserted] = keys.try_emplace(first.key, m_groups.size());
+
+            if (inserted)
+            {
+                m_groups.emplace_back(first.key);
+            }
+
+            auto &group = m_groups[it->second];
+
+            if (first.expression.has_value())
+            {
+                group.patterns.emplace_back(std::move(*first.expression), rule);
+            }
+            else
+            {
+                group.values[first.value].emplace_back(rule);
+            }
+
+            // Only the first key is indexed, so a rule is looked at once, without counting its matched keys per call
+            conditions.erase(conditions.begin());
+            m_rests.emplace_back(std::move(conditions));
+        }
+    }
+
+    bool matcher::empty() const
+    {
+        return !m_always && m_rests.empty();
+    }
+} // namespace vencord
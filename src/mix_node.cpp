@@ -0,0 +1,390 @@
+#include "mix_node.hpp"
+#include "kernels.hpp"
+#include "logger.hpp"
+
+#include <span>
+#include <array>
+#include <atomic>
+#include <format>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <pipewire/filter.h>
+#include <pipewire/keys.h>
+
+namespace vencord
+{
+    using enum logger::level;
+
+    static constexpr auto channels    = std::array{"FL", "FR"};
+    static constexpr auto max_quantum = 8192uz; // Largest quantum PipeWire schedules, sizes the capture buffers
+
+    struct mix_node::impl
+    {
+        struct group
+        {
+            std::uint32_t source;
+            std::array<void *, channels.size()> ports;
+            level_table::slot *slot;
+        };
+
+        // Everything the processing thread reads, replaced as a whole whenever inputs change
+        struct snapshot
+        {
+            std::vector<group> inputs;
+            capture_ring *ring{nullptr};
+        };
+
+      public:
+        pw_filter *filter{nullptr};
+        spa_hook listener{};
+
+      public:
+        std::atomic<float> gain{1.0f};
+        std::array<void *, channels.size()> outputs{}; // Unset for meters
+        std::shared_ptr<level_table> levels;
+
+      public:
+        std::shared_ptr<capture_ring> ring;
+        std::array<std::vector<float>, channels.size()> scratch; // Sum of all inputs, only allocated for captures
+
+      public:
+        std::unique_ptr<snapshot> current{std::make_unique<snapshot>()}; // Owned by the main thread
+        std::atomic<const snapshot *> active{current.get()};             // Read by the processing thread
+        std::atomic<std::uint64_t> cycles{0};                            // Odd while a cycle is being processed
+
+      public:
+        ~impl();
+
+      public:
+        std::unique_ptr<snapshot> publish(std::unique_ptr<snapshot>);
+        void process(std::uint32_t samples, std::uint32_t rate);
+    };
+
+    mix_node::impl::~impl()
+    {
+        if (filter)
+        {
+            spa_hook_remove(&listener);
+            pw_filter_destroy(filter);
+        }
+
+        for (const auto &input : current->inputs)
+        {
+            if (levels)
+            {
+                levels->release(input.slot);
+            }
+        }
+    }
+
+    std::unique_ptr<mix_node::impl::snapshot> mix_node::impl::publish(std::unique_ptr<snapshot> next)
+    {
+        active.store(next.get());
+
+        auto previous = std::exchange(current, std::move(next));
+        const auto at = cycles.load();
+
+        // A cycle that started before the swap may still read the previous snapshot, it is done within one quantum
+        while (at % 2 == 1 && cycles.load() == at)
+        {
+            std::this_thread::yield();
+        }
+
+        return previous;
+    }
+
+    void mix_node::impl::process(std::uint32_t samples, std::uint32_t rate)
+    {
+        cycles.fetch_add(1);
+
+        const auto &[inputs, ring] = *active.load();
+        const auto capturing       = ring && !scratch.front().empty();
+        const auto gain            = this->gain.load(std::memory_order_relaxed);
+
+        if (capturing)
+        {
+            samples = std::min<std::uint32_t>(samples, scratch.front().size());
+        }
+
+        for (auto channel = 0uz; channels.size() > channel; ++channel)
+        {
+            auto *const out    = outputs[channel] ? pw_filter_get_dsp_buffer(outputs[channel], samples) : nullptr;
+            auto *const buffer = out ? static_cast<float *>(out) : (capturing ? scratch[channel].data() : nullptr);
+            const auto dst     = std::span{buffer, buffer ? samples : 0};
+
+            std::ranges::fill(dst, 0.0f);
+
+            for (const auto &input : inputs)
+            {
+                const auto *in = static_cast<const float *>(pw_filter_get_dsp_buffer(input.ports[channel], samples));
+
+                if (!in)
+                {
+                    continue;
+                }
+
+                const auto src = std::span{in, samples};
+
+                if (input.slot)
+                {
+                    const auto [peak, rms] = kernels::measure(src);
+
+                    input.slot->peak[channel].store(peak, std::memory_order_relaxed);
+                    input.slot->rms[channel].store(rms, std::memory_order_relaxed);
+
+                    level_table::hold(input.slot->held[channel], peak);
+                }
+
+                if (!dst.empty() && gain != 0.0f)
+                {
+                    kernels::mix(dst, src, gain);
+                }
+            }
+
+            kernels::clip(dst);
+        }
+
+        if (capturing)
+        {
+            const auto sums = std::array<std::span<const float>, channels.size()>{
+                std::span{scratch[0].data(), samples},
+                std::span{scratch[1].data(), samples},
+            };
+
+            ring->write(sums, rate);
+        }
+
+        cycles.fetch_add(1, std::memory_order_release);
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static void *add_port(pw_filter *filter, pw_direction direction, const std::string &name, const char *channel,
+                          const std::string &group = {})
+    {
+        auto *const props = pw_properties_new(PW_KEY_FORMAT_DSP, "32 bit float mono audio", //
+                                              PW_KEY_PORT_NAME, name.c_str(),               //
+                                              PW_KEY_AUDIO_CHANNEL, channel,                //
+                                              nullptr);
+
+        if (!group.empty())
+        {
+            pw_properties_set(props, "port.group", group.c_str());
+        }
+
+        return pw_filter_add_port(filter, direction, PW_FILTER_PORT_FLAG_MAP_BUFFERS, 0, props, nullptr, 0);
+    }
+
+    mix_node::mix_node() : m_impl(std::make_shared<impl>()) {}
+
+    mix_node::~mix_node() = default;
+
+    std::optional<std::uint32_t> mix_node::id() const
+    {
+        const auto rtn = pw_filter_get_node_id(m_impl->filter);
+
+        if (rtn == SPA_ID_INVALID)
+        {
+            return std::nullopt;
+        }
+
+        return rtn;
+    }
+
+    void mix_node::mute(bool value)
+    {
+        m_impl->gain.store(value ? 0.0f : 1.0f, std::memory_order_relaxed);
+        logger::get()(debug, "[mix_node] (mute) {}", value ? "muted" : "unmuted");
+    }
+
+    void mix_node::latency(const std::string &value)
+    {
+        const auto item = spa_dict_item{PW_KEY_NODE_LATENCY, value.empty() ? nullptr : value.c_str()};
+        const auto dict = SPA_DICT_INIT(&item, 1);
+
+        // Removing the key lets the graph pick the quantum again
+        pw_filter_update_properties(m_impl->filter, nullptr, &dict);
+        logger::get()(debug, "[mix_node] (latency) {}", value.empty() ? "graph" : value);
+    }
+
+    void mix_node::meter(std::shared_ptr<level_table> levels)
+    {
+        // Every link re-applies the options, re-acquiring the slots of the same table would hold each node twice
+        if (levels == m_impl->levels)
+        {
+            return;
+        }
+
+        auto next = std::make_unique<impl::snapshot>(*m_impl->current);
+
+        for (auto &input : next->inputs)
+        {
+            input.slot = levels ? levels->acquire(input.source) : nullptr;
+        }
+
+        const auto previous = m_impl->publish(std::move(next));
+
+        for (const auto &input : previous->inputs)
+        {
+            if (m_impl->levels)
+            {
+                m_impl->levels->release(input.slot);
+            }
+        }
+
+        m_impl->levels = std::move(levels);
+        logger::get()(debug, "[mix_node] (meter) metering {}", m_impl->levels ? "enabled" : "disabled");
+    }
+
+    void mix_node::capture(std::shared_ptr<capture_ring> ring)
+    {
+        auto next  = std::make_unique<impl::snapshot>(*m_impl->current);
+        next->ring = ring.get();
+
+        // The previous ring is only released once the processing thread can no longer write to it
+        m_impl->publish(std::move(next));
+        m_impl->ring = std::move(ring);
+        logger::get()(debug, "[mix_node] (capture) capturing {}", m_impl->ring ? "enabled" : "disabled");
+    }
+
+    std::string mix_node::group(std::uint32_t source)
+    {
+        return std::format("venmic-{}", source);
+    }
+
+    std::shared_ptr<std::uint32_t> mix_node::add(std::uint32_t source)
+    {
+        const auto group = mix_node::group(source);
+        auto ports       = std::array<void *, channels.size()>{};
+
+        for (auto channel = 0uz; channels.size() > channel; ++channel)
+        {
+            const auto name = std::format("input_{}_{}", source, channels[channel]);
+            ports[channel]  = add_port(m_impl->filter, PW_DIRECTION_INPUT, name, channels[channel], group);
+        }
+
+        auto *const slot = m_impl->levels ? m_impl->levels->acquire(source) : nullptr;
+
+        if (m_impl->levels && !slot)
+        {
+            logger::get()(warn, "[mix_node] (add) no level slot left for {}", source);
+        }
+
+        auto next = std::make_unique<impl::snapshot>(*m_impl->current);
+        next->inputs.emplace_back(source, ports, slot);
+
+        m_impl->publish(std::move(next));
+        logger::get()(debug, "[mix_node] (add) added input group for {}", source);
+
+        const auto remove = [owner = std::weak_ptr{m_impl}](auto *item)
+        {
+            auto self = owner.lock();
+            auto id   = *item;
+
+            delete item;
+
+            if (!self)
+            {
+                return;
+            }
+
+            auto next     = std::make_unique<impl::snapshot>(*self->current);
+            const auto it = std::ranges::find(next->inputs, id, &impl::group::source);
+
+            if (it == next->inputs.end())
+            {
+                return;
+            }
+
+            const auto removed = *it;
+            next->inputs.erase(it);
+
+            // Ports are only removed once the processing thread no longer reads from them
+            self->publish(std::move(next));
+            std::ranges::for_each(removed.ports, pw_filter_remove_port);
+
+            if (self->levels)
+            {
+                self->levels->release(removed.slot);
+            }
+
+            logger::get()(debug, "[mix_node] (remove) removed input group for {}", id);
+        };
+
+        return {new std::uint32_t{source}, remove};
+    }
+
+    std::unique_ptr<mix_node> mix_node::create(pw_core *core, const std::string &name, kind type,
+                                               const std::string &latency, std::shared_ptr<level_table> levels)
+    {
+        static constexpr auto events = pw_filter_events{
+            .version = PW_VERSION_FILTER_EVENTS,
+            .process =
+                [](void *data, spa_io_position *position)
+            {
+                static_cast<impl *>(data)->process(position->clock.duration, position->clock.rate.denom);
+            },
+        };
+
+        auto *const props = pw_properties_new(PW_KEY_MEDIA_TYPE, "Audio",            //
+                                              PW_KEY_NODE_NAME, name.c_str(),        //
+                                              PW_KEY_NODE_DESCRIPTION, name.c_str(), //
+                                              nullptr);
+
+        if (!latency.empty())
+        {
+            pw_properties_set(props, PW_KEY_NODE_LATENCY, latency.c_str());
+        }
+
+        if (type == kind::mixer)
+        {
+            pw_properties_set(props, PW_KEY_MEDIA_CATEGORY, "Source");
+            pw_properties_set(props, PW_KEY_MEDIA_CLASS, "Audio/Source/Virtual");
+        }
+        else
+        {
+            // Meters and captures are only ever linked by venmic, the session manager should leave them alone
+            pw_properties_set(props, PW_KEY_NODE_AUTOCONNECT, "false");
+        }
+
+        auto *const filter = pw_filter_new(core, name.c_str(), props);
+
+        if (!filter)
+        {
+            logger::get()(error, "[mix_node] (create) failed to create filter");
+            return nullptr;
+        }
+
+        auto rtn = std::unique_ptr<mix_node>(new mix_node);
+
+        rtn->m_impl->filter = filter;
+        rtn->m_impl->levels = std::move(levels);
+
+        if (type == kind::capture)
+        {
+            std::ranges::for_each(rtn->m_impl->scratch, [](auto &buffer) { buffer.resize(max_quantum); });
+        }
+
+        pw_filter_add_listener(filter, &rtn->m_impl->listener, &events, rtn->m_impl.get());
+
+        for (auto channel = 0uz; type == kind::mixer && channels.size() > channel; ++channel)
+        {
+            const auto port               = std::format("output_{}", channels[channel]);
+            rtn->m_impl->outputs[channel] = add_port(filter, PW_DIRECTION_OUTPUT, port, channels[channel]);
+        }
+
+        // Inputs are swapped in as snapshots, so processing can run on the realtime thread without taking a lock
+        if (const auto res = pw_filter_connect(filter, PW_FILTER_FLAG_RT_PROCESS, nullptr, 0); res < 0)
+        {
+            logger::get()(error, "[mix_node] (create) failed to connect filter: {}", res);
+            return nullptr;
+        }
+
+        static constexpr auto names = std::array{"mixer", "meter", "capture"};
+        logger::get()("[mix_node] (create) created {} using {} kernels", names[std::to_underlying(type)], kernels::name());
+
+        return rtn;
+    }
+} // namespace vencord
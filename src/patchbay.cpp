@@ -30,12 +30,55 @@ namespace vencord
         m_impl->sender->send(vencord::unmute{});
     }
 
+    void patchbay::start_capture(std::uint32_t seconds)
+    {
+        m_impl->sender->send(vencord::start_capture{seconds});
+    }
+
+    void patchbay::stop_capture()
+    {
+        m_impl->sender->send(vencord::stop_capture{});
+    }
+
     std::vector<node> patchbay::list(std::vector<std::string> props)
     {
+        auto lock = std::lock_guard{m_impl->requests};
+
         m_impl->sender->send(vencord::list{std::move(props)});
         return *m_impl->receiver->recv_as<std::vector<node>>();
     }
 
+    std::vector<latency> patchbay::measure()
+    {
+        auto lock = std::lock_guard{m_impl->requests};
+
+        m_impl->sender->send(vencord::measure{});
+        return *m_impl->receiver->recv_as<std::vector<latency>>();
+    }
+
+    std::vector<load> patchbay::telemetry()
+    {
+        auto lock = std::lock_guard{m_impl->requests};
+
+        m_impl->sender->send(vencord::telemetry{});
+        return *m_impl->receiver->recv_as<std::vector<load>>();
+    }
+
+    std::string patchbay::metrics() const
+    {
+        return m_impl->stats.render();
+    }
+
+    std::string patchbay::spans() const
+    {
+        return tracer::get().dump();
+    }
+
+    std::vector<level> patchbay::levels() const
+    {
+        return m_impl->levels->read();
+    }
+
     patchbay &patchbay::get()
     {
         static std::unique_ptr<patchbay> instance;
@@ -56,6 +99,11 @@ namespace vencord
         return *instance;
     }
 
+    bool patchbay::matches(const std::vector<node> &rules, const node &props)
+    {
+        return matcher{rules}.matches(props);
+    }
+
     bool patchbay::has_pipewire()
     {
         static std::optional<bool> cached;
@@ -1,6 +1,8 @@
 #include "patchbay.impl.hpp"
 #include "logger.hpp"
+#include "recorder.hpp"
 
+#include <limits>
 #include <string_view>
 
 #include <rohrkabel/device/device.hpp>
@@ -11,11 +13,167 @@
 
 #include <glaze/glaze.hpp>
 
+#include <pipewire/port.h>
+#include <pipewire/loop.h>
+#include <pipewire/main-loop.h>
+#include <pipewire/extensions/profiler.h>
+
 namespace vencord
 {
     using enum logger::level;
     using namespace std::chrono_literals;
 
+    static constexpr auto silence       = 1e-4f; // Peak below which a node counts as silent (-80 dBFS)
+    static constexpr auto gate_interval = 100ms; // How often linked nodes are checked for silence while gating
+    static constexpr auto flush_timeout = 20ms;  // Longest a burst is batched when the server is slow to answer a sync
+    static constexpr auto profile_warm  = 250ms; // How long the request that binds the profiler waits for the first cycles
+    static constexpr auto profile_idle  = 120s;  // How long the profiler stays bound after the last telemetry request
+    static constexpr auto max_capture   = 300u;  // Longest capture in seconds, about 110 MiB at 48 kHz
+
+    static std::uint32_t parse(std::string_view value) // NOLINT(*-anonymous-namespace)
+    {
+        auto rtn = std::uint32_t{};
+
+        if (std::from_chars(value.data(), value.data() + value.size(), rtn).ec != std::errc{})
+        {
+            return 0;
+        }
+
+        return rtn;
+    }
+
+    static std::uint32_t rate_of(const properties &props) // NOLINT(*-anonymous-namespace)
+    {
+        auto value = props["audio.rate"];
+
+        if (const auto rate = props["node.rate"]; value.empty() && rate.contains('/'))
+        {
+            // node.rate is given as a fraction, i.e. "1/48000"
+            value = rate.substr(rate.find('/') + 1);
+        }
+
+        return parse(value);
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static std::vector<std::string_view> fold(std::string_view channel, std::size_t index, std::size_t count)
+    {
+        using namespace std::string_view_literals;
+
+        static constexpr auto left   = std::array{"FL"sv, "FLC"sv, "SL"sv, "RL"sv, "RLC"sv, "TFL"sv, "TRL"sv, "TSL"sv};
+        static constexpr auto right  = std::array{"FR"sv, "FRC"sv, "SR"sv, "RR"sv, "RRC"sv, "TFR"sv, "TRR"sv, "TSR"sv};
+        static constexpr auto center = std::array{"MONO"sv, "FC"sv, "RC"sv, "TC"sv, "TFC"sv, "TRC"sv};
+
+        if (count == 1 || channel.empty() || std::ranges::contains(center, channel))
+        {
+            return {"FL", "FR"};
+        }
+
+        if (std::ranges::contains(left, channel))
+        {
+            return {"FL"};
+        }
+
+        if (std::ranges::contains(right, channel))
+        {
+            return {"FR"};
+        }
+
+        if (channel.starts_with("AUX"))
+        {
+            return {index % 2 == 0 ? "FL" : "FR"};
+        }
+
+        // The low frequency channel is dropped, as in most stereo downmixes
+        return {};
+    }
+
+    static bool owned(const properties &props) // NOLINT(*-anonymous-namespace)
+    {
+        static const auto venmic = matcher{{
+            {{"node.name", "prefix:venmic-"}},
+            {{"node.name", "prefix:vencord-"}},
+            {{"node.description", "prefix:venmic-loopback"}},
+        }};
+
+        return venmic.matches(props);
+    }
+
+    static std::string latency_of(const audio_format &format) // NOLINT(*-anonymous-namespace)
+    {
+        if (format.latency == 0)
+        {
+            return {};
+        }
+
+        // PipeWire scales the requested latency to the graph rate, 48 kHz is its default
+        return std::format("{}/{}", format.latency, format.rate > 0 ? format.rate : 48000);
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static std::string loopback_args(const std::string &capture, std::string_view from, const std::string &playback,
+                                     std::string_view to, const std::string &latency)
+    {
+        const auto node = [&latency](const std::string &name, std::string_view target)
+        {
+            auto rtn = std::format(R"("node.name": "{0}", "node.description": "{0}", "target.object": "{1}")", name, target);
+
+            if (!latency.empty())
+            {
+                rtn += std::format(R"(, "node.latency": "{}")", latency);
+            }
+
+            return rtn;
+        };
+
+        return std::format(R"({{ "capture.props": {{ {} }}, "playback.props": {{ {} }} }})", node(capture, from),
+                           node(playback, to));
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static void arm(pw_main_loop *loop, spa_source *timer, std::chrono::nanoseconds interval, bool repeat = true)
+    {
+        // A zero interval disarms the timer
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(interval);
+
+        auto value = timespec{
+            .tv_sec  = static_cast<time_t>(seconds.count()),
+            .tv_nsec = static_cast<long>((interval - seconds).count()),
+        };
+
+        auto once = timespec{};
+
+        pw_loop_update_timer(pw_main_loop_get_loop(loop), timer, &value, repeat ? &value : &once, false);
+    }
+
+    static pw::factory null_node(std::string name, std::string media_class, // NOLINT(*-anonymous-namespace)
+                                 const audio_format &format)
+    {
+        auto rtn = pw::factory{
+            .name  = "adapter",
+            .props = {
+                {"factory.name", "support.null-audio-sink"},
+                {"node.name", name},
+                {"node.description", name},
+                {"media.class", std::move(media_class)},
+                {"audio.channels", std::to_string(format.positions.size())},
+                {"audio.position", format.positions | std::views::join_with(',') | std::ranges::to<std::string>()},
+            },
+        };
+
+        if (format.rate > 0)
+        {
+            rtn.props.emplace("audio.rate", std::to_string(format.rate));
+        }
+
+        if (format.latency > 0)
+        {
+            rtn.props.emplace("node.latency", latency_of(format));
+        }
+
+        return rtn;
+    }
+
     patchbay::impl::impl()
     {
         auto [pw_sender, pw_receiver] = pw::channel<pw_recipe>();
@@ -41,7 +199,7 @@ namespace vencord
 
     void patchbay::impl::cleanup(clean kind)
     {
-        virt_links.clear();
+        decisions.clear();
         workaround_target.reset();
 
         if (kind != clean::with_mic)
@@ -49,17 +207,32 @@ namespace vencord
             return;
         }
 
+        virt_links.clear();
         options.reset();
+        rules = {};
+        meters.reset();
+        ++captures;
+        captured = {};
+        capturer.reset();
         virt_mic.reset();
+
+        // Without the sharing setup there is nothing left to profile
+        release_profiler();
+
+        if (gate_timer)
+        {
+            arm(loop->get(), gate_timer, 0ns);
+        }
+
+        force_quantum(std::nullopt);
+        publish();
     }
 
-    coco::task<void> patchbay::impl::create_mic(bool should_mute)
+    coco::task<void> patchbay::impl::create_mic(bool should_mute, audio_format format)
     {
-        auto receiver = co_await core->create(pw::null_factory{
-            .type      = pw::null_factory::kind::sink,
-            .name      = "vencord-sink",
-            .positions = {"FL", "FR"},
-        });
+        const auto scope = span{"create_mic"};
+
+        auto receiver = co_await core->create<pw::node>(null_node("vencord-sink", "Audio/Sink", format));
 
         if (!receiver.has_value())
         {
@@ -68,23 +241,19 @@ namespace vencord
         }
 
         const auto receiver_info = receiver->info();
-        auto receiver_ports      = std::map<std::uint32_t, pw::port_info>{};
+        const auto port_count    = 2 * format.positions.size(); // Inputs and monitors
 
-        while ((receiver_ports = ports_of(receiver_info)).size() < 4)
+        while (ports_of(receiver_info.id).size() < port_count)
         {
-            co_await core->sync();
+            co_await sync();
         }
 
         if (should_mute)
         {
-            co_await mute(receiver_info, true);
+            co_await mute(receiver_info.id, true);
         }
 
-        auto source = co_await core->create(pw::null_factory{
-            .type      = pw::null_factory::kind::source,
-            .name      = "vencord-screen-share",
-            .positions = {"FL", "FR"},
-        });
+        auto source = co_await core->create<pw::node>(null_node("vencord-screen-share", "Audio/Source/Virtual", format));
 
         if (!source.has_value())
         {
@@ -92,11 +261,10 @@ namespace vencord
         }
 
         const auto source_info = source->info();
-        auto source_ports      = std::map<std::uint32_t, pw::port_info>{};
 
-        while ((source_ports = ports_of(source_info)).size() < 4)
+        while (ports_of(source_info.id).size() < port_count)
         {
-            co_await core->sync();
+            co_await sync();
         }
 
         static const auto is_output = [](const auto &info)
@@ -107,16 +275,16 @@ namespace vencord
         {
             return info.direction == pw::port_direction::input;
         };
-        static const auto matching_port = [](auto from, auto to)
+        static const auto matching_port = [](const auto &from, const auto &to)
         {
             return from.props["audio.channel"] == to.props["audio.channel"];
         };
 
-        const auto candidates = source_ports                   //
+        const auto candidates = ports_of(source_info.id)       //
                                 | std::views::values           //
                                 | std::views::filter(is_input) //
                                 | std::ranges::to<std::vector>();
-        const auto sources    = receiver_ports                  //
+        const auto sources    = ports_of(receiver_info.id)      //
                                 | std::views::values            //
                                 | std::views::filter(is_output) //
                                 | std::ranges::to<std::vector>();
@@ -152,20 +320,223 @@ namespace vencord
             .loopback_receiver = std::move(*receiver),
             .chromium_source   = std::move(*source),
             .links             = std::move(links),
+            .format            = format,
         };
 
-        logger::get()("[patchbay] (create_mic) created sharing setup");
+        logger::get()("[patchbay] (create_mic) created sharing setup ({} channel(s), {})", format.positions.size(),
+                      format.rate > 0 ? std::format("{} Hz", format.rate) : "graph rate");
         logger::get()("[patchbay] (create_mic) ├ receiver: {}", virt_mic->loopback_receiver.id());
         logger::get()("[patchbay] (create_mic) └ source: {}", virt_mic->chromium_source.id());
     }
 
-    coco::task<void> patchbay::impl::mute(pw::node_info info, bool value)
+    coco::task<void> patchbay::impl::create_source(bool should_mute, audio_format format)
+    {
+        const auto scope = span{"create_source"};
+
+        auto source = co_await core->create<pw::node>(null_node("vencord-screen-share", "Audio/Source/Virtual", format));
+
+        if (!source.has_value())
+        {
+            co_return logger::get()(error, "[patchbay] (create_source) failed to create source: {}", source.error().message);
+        }
+
+        const auto id = source->info().id;
+
+        // A virtual source has input ports as well, so nodes can be linked into it without a sink in between
+        while (ports_of(id).size() < 2 * format.positions.size())
+        {
+            co_await sync();
+        }
+
+        if (should_mute)
+        {
+            co_await mute(id, true);
+        }
+
+        auto receiver = co_await registry->bind<pw::node>(id);
+
+        if (!receiver.has_value())
+        {
+            co_return logger::get()(error, "[patchbay] (create_source) failed to bind source {}", id);
+        }
+
+        virt_mic = share_node{
+            .loopback_receiver = std::move(*receiver),
+            .chromium_source   = std::move(*source),
+            .duplex            = true,
+            .format            = format,
+        };
+
+        logger::get()("[patchbay] (create_source) created single node sharing setup: {} ({} channel(s), {})", id,
+                      format.positions.size(), format.rate > 0 ? std::format("{} Hz", format.rate) : "graph rate");
+    }
+
+    coco::task<void> patchbay::impl::create_mixer(bool should_mute, audio_format format)
+    {
+        const auto scope = span{"create_mixer"};
+
+        auto mixer = mix_node::create(core->get(), "vencord-screen-share", mix_node::kind::mixer, latency_of(format));
+
+        if (!mixer)
+        {
+            co_return logger::get()(error, "[patchbay] (create_mixer) failed to create mixer");
+        }
+
+        mixer->mute(should_mute);
+
+        while (!mixer->id().has_value() || ports_of(*mixer->id()).size() < 2)
+        {
+            co_await sync();
+        }
+
+        const auto id = *mixer->id();
+
+        auto receiver = co_await registry->bind<pw::node>(id);
+        auto source   = co_await registry->bind<pw::node>(id);
+
+        if (!receiver.has_value() || !source.has_value())
+        {
+            co_return logger::get()(error, "[patchbay] (create_mixer) failed to bind mixer {}", id);
+        }
+
+        virt_mic = share_node{
+            .loopback_receiver = std::move(*receiver),
+            .chromium_source   = std::move(*source),
+            .mixer             = std::move(mixer),
+            .format            = format,
+        };
+
+        logger::get()("[patchbay] (create_mixer) created mixing setup: {}", id);
+    }
+
+    coco::task<void> patchbay::impl::create_meter()
+    {
+        auto meter = mix_node::create(core->get(), "venmic-meter", mix_node::kind::meter, {}, levels);
+
+        if (!meter)
+        {
+            co_return logger::get()(error, "[patchbay] (create_meter) failed to create meter");
+        }
+
+        while (!meter->id().has_value())
+        {
+            co_await sync();
+        }
+
+        meters = std::move(meter);
+
+        logger::get()("[patchbay] (create_meter) created meter: {}", *meters->id());
+    }
+
+    coco::task<void> patchbay::impl::create_capture(std::uint32_t seconds)
+    {
+        const auto scope = span{"create_capture"};
+
+        // Every start and stop bumps the generation, so a stop that arrives while we wait on the server wins
+        const auto generation = captures;
+        const auto current    = [this, generation]
+        {
+            return captures == generation && virt_mic.has_value();
+        };
+
+        auto node = mix_node::create(core->get(), "venmic-capture", mix_node::kind::capture);
+
+        if (!node)
+        {
+            co_return logger::get()(error, "[patchbay] (create_capture) failed to create capture");
+        }
+
+        while (!node->id().has_value())
+        {
+            co_await sync();
+
+            if (!current())
+            {
+                co_return;
+            }
+        }
+
+        const auto source = virt_mic->chromium_source.id();
+        const auto target = *node->id();
+        const auto group  = mix_node::group(source);
+
+        auto added = node->add(source);
+        auto ports = port_pairs{};
+
+        // The ports of a new input group only become known once the server announced them
+        for (auto attempt = 0; attempt < 50 && ports.empty(); ++attempt)
+        {
+            co_await sync();
+
+            if (!current())
+            {
+                co_return;
+            }
+
+            // Captures are stereo like the mixer, so only FL and FR of wider sharing nodes are captured
+            ports = route(source, target, group, mapping::partial);
+        }
+
+        if (ports.empty())
+        {
+            co_return logger::get()(warn, "[patchbay] (create_capture) could not route {} into {}", source, target);
+        }
+
+        // Without a fixed rate the sharing node runs at the rate of the graph
+        auto rate = virt_mic->format.rate > 0 ? virt_mic->format.rate : format_of(source, pw::port_direction::output).rate;
+
+        if (rate == 0)
+        {
+            rate = parse(clock["clock.rate"]);
+        }
+
+        auto ring = capture_ring::create(capture_file::path(), 2, seconds * (rate > 0 ? rate : 48000));
+
+        if (!ring)
+        {
+            co_return logger::get()(error, "[patchbay] (create_capture) failed to create capture file");
+        }
+
+        node->capture(std::move(ring));
+
+        auto links = std::vector<pw::link>{};
+
+        for (const auto &[output, input] : ports)
+        {
+            auto link = co_await core->create(pw::link_factory{
+                .input  = input,
+                .output = output,
+            });
+
+            if (!current())
+            {
+                co_return;
+            }
+
+            if (!link.has_value())
+            {
+                logger::get()(warn, "[patchbay] (create_capture) could not create link ({} -> {}): {}", output, input,
+                              link.error().message);
+                continue;
+            }
+
+            links.emplace_back(std::move(*link));
+        }
+
+        capturer = std::move(node);
+        captured = {.input = std::move(added), .ports = std::move(ports), .links = std::move(links)};
+
+        logger::get()("[patchbay] (create_capture) capturing {} at {} Hz for {}s into {}", source, rate, seconds,
+                      capture_file::path().string());
+    }
+
+    coco::task<void> patchbay::impl::mute(std::uint32_t id, bool value)
     {
-        auto node = co_await registry->bind<pw::node>(info.id);
+        auto node = co_await registry->bind<pw::node>(id);
 
         if (!node.has_value())
         {
-            co_return logger::get()(error, "[patchbay] (mute) failed to bind {}: {}", info.id, node.error().message);
+            co_return logger::get()(error, "[patchbay] (mute) failed to bind {}: {}", id, node.error().message);
         }
 
         auto builder = pw::spa::pod_builder::create();
@@ -184,28 +555,16 @@ namespace vencord
         }
 
         node->set_param(pw::spa::param::props, 0, *pod);
-        co_await core->sync();
+        co_await sync();
 
-        logger::get()(debug, "[patchbay] (mute) {} {}", value ? "muted" : "unmuted", info.id);
+        logger::get()(debug, "[patchbay] (mute) {} {}", value ? "muted" : "unmuted", id);
+        recorder::get()(recorder::event::muted, id, value);
     }
 
-    static bool matches(const std::vector<node> &targets, pw::spa::dict props) // NOLINT(*-anonymous-namespace)
+    coco::task<void> patchbay::impl::redirect(std::optional<std::uint32_t> id)
     {
-        const auto props_match = [&](const auto &prop)
-        {
-            return props[prop.first] == prop.second;
-        };
-
-        const auto has_target = [&](const auto &target)
-        {
-            return std::ranges::all_of(target, props_match);
-        };
-
-        return std::ranges::any_of(targets, has_target);
-    }
+        const auto scope = span{"redirect"};
 
-    coco::task<void> patchbay::impl::redirect(std::optional<pw::node_info> info)
-    {
         if (!options.has_value())
         {
             co_return;
@@ -223,23 +582,23 @@ namespace vencord
             co_return;
         }
 
-        const auto pred = [this](const auto &item)
+        const auto pred = [this](auto target)
         {
-            return matches(options->workaround, item.props);
+            const auto node = nodes.find(target);
+            return node != nodes.end() && rules.workaround.matches(node->second.props);
         };
 
-        if (!info.has_value())
+        if (!id.has_value())
         {
-            const auto node = std::ranges::find_if(nodes, pred, [](auto &&item) { return item.second; });
-            info            = (node == nodes.end() ? std::nullopt : std::optional<pw::node_info>{node->second});
+            id = find_matching(rules.workaround, options->workaround);
         }
-        else if (!pred(*info))
+        else if (!pred(*id))
         {
-            logger::get()(debug, "[patchbay] (redirect) {} did not match workaround criteria", info->id);
+            logger::get()(debug, "[patchbay] (redirect) {} did not match workaround criteria", *id);
             co_return;
         }
 
-        if (!info.has_value())
+        if (!id.has_value())
         {
             logger::get()(debug, "[patchbay] (redirect) could not find node matching redirect criteria");
             co_return;
@@ -268,456 +627,1507 @@ namespace vencord
 
         workaround_target.reset();
         {
-            meta->value.set_property(info->id, "node.target", "Spa:Id", std::format("{}", virt_mic->chromium_source.id()));
-            meta->value.set_property(info->id, "target.object", "Spa:Id", serial);
+            meta->value.set_property(*id, "node.target", "Spa:Id", std::format("{}", virt_mic->chromium_source.id()));
+            meta->value.set_property(*id, "target.object", "Spa:Id", serial);
         }
-        workaround_target = make(info->id, cleanup);
+        workaround_target = make(*id, cleanup);
 
-        logger::get()(debug, "[patchbay] (redirect) redirected {}", info->id);
+        logger::get()(debug, "[patchbay] (redirect) redirected {}", *id);
+        recorder::get()(recorder::event::redirected, *id);
     }
 
-    bool patchbay::impl::should_link(const pw::node_info &node)
+    coco::task<void> patchbay::impl::sync()
     {
-        if (!options.has_value())
-        {
-            return false;
-        }
-
-        logger::get()(debug, "[patchbay] (should_link) checking {}", node.id);
+        const auto start = std::chrono::steady_clock::now();
+        co_await core->sync();
+        stats.sync.observe(std::chrono::steady_clock::now() - start);
+    }
 
-        auto props = node.props;
+    void patchbay::impl::publish()
+    {
+        // Gated links and loopbacks are counted by their `tally`, so nothing has to be recounted here
+        const auto gated = stats.gated.load(std::memory_order_relaxed);
+
+        stats.nodes.store(nodes.size(), std::memory_order_relaxed);
+        stats.ports.store(ports.size(), std::memory_order_relaxed);
+        stats.links.store(links.size(), std::memory_order_relaxed);
+        stats.virt_links.store(virt_links.size(), std::memory_order_relaxed);
+        stats.active.store(virt_links.size() - gated, std::memory_order_relaxed);
+    }
 
-        if (props["node.description"].starts_with("venmic-loopback"))
+    void patchbay::impl::force_quantum(std::optional<std::uint32_t> value)
+    {
+        if (!settings.has_value())
         {
-            logger::get()(debug, "[patchbay] (should_link) └ is virt-mic loopback", node.id);
-            return false;
+            if (value.has_value())
+            {
+                logger::get()(warn, "[patchbay] (force_quantum) settings metadata not available");
+            }
+
+            return;
         }
 
-        if (!options->include.empty() && !matches(options->include, node.props))
+        if (!value.has_value() && restore_quantum.has_value())
         {
-            logger::get()(debug, "[patchbay] (should_link) └ did not match include criteria", node.id);
-            return false;
+            settings->value.set_property(0, "clock.force-quantum", "", *restore_quantum);
+            logger::get()(debug, "[patchbay] (force_quantum) restored quantum: {}", *restore_quantum);
+
+            restore_quantum.reset();
         }
 
-        if (matches(options->exclude, node.props))
+        if (!value.has_value())
         {
-            logger::get()(debug, "[patchbay] (should_link) └ matched exclude criteria", node.id);
-            return false;
+            return;
         }
 
-        auto ports = ports_of(node);
-
-        if (ports.empty())
+        if (!restore_quantum.has_value())
         {
-            logger::get()(debug, "[patchbay] (should_link) └ has no ports", node.id);
-            return false;
+            const auto current = clock["clock.force-quantum"];
+            restore_quantum.emplace(current.empty() ? "0" : current);
         }
 
-        if (virt_mic.has_value() && virt_mic->chromium_source.id() == node.id)
+        settings->value.set_property(0, "clock.force-quantum", "", std::to_string(*value));
+        logger::get()(debug, "[patchbay] (force_quantum) forced quantum: {}", *value);
+        recorder::get()(recorder::event::quantum_forced, *value);
+    }
+
+    struct latency_query // NOLINT(*-internal-linkage)
+    {
+        spa_hook listener{};
+        std::optional<spa_latency_info> upstream;
+    };
+
+    coco::task<std::optional<spa_latency_info>> patchbay::impl::upstream(std::vector<std::uint32_t> ports)
+    {
+        static constexpr auto events = pw_port_events{
+            .version = PW_VERSION_PORT_EVENTS,
+            .param =
+                [](void *data, int, std::uint32_t id, std::uint32_t, std::uint32_t, const spa_pod *param)
+            {
+                auto info = spa_latency_info{};
+
+                // The input direction describes the latency accumulated upstream of the port
+                if (id != SPA_PARAM_Latency || spa_latency_parse(param, &info) < 0 || info.direction != SPA_DIRECTION_INPUT)
+                {
+                    return;
+                }
+
+                auto &query = static_cast<latency_query *>(data)->upstream;
+
+                if (!query.has_value())
+                {
+                    query.emplace(info);
+                    return;
+                }
+
+                spa_latency_info_combine(&*query, &info);
+            },
+        };
+
+        auto query = latency_query{};
+
+        for (const auto &id : ports)
         {
-            logger::get()(debug, "[patchbay] (should_link) └ is the virt-mic-source", node.id);
-            return false;
+            auto port = co_await registry->bind<pw::port>(id);
+
+            if (!port.has_value())
+            {
+                logger::get()(warn, "[patchbay] (upstream) failed to bind {}: {}", id, port.error().message);
+                continue;
+            }
+
+            auto *const raw = port->get();
+
+            pw_port_add_listener(raw, &query.listener, &events, &query);
+            pw_port_enum_params(raw, 0, SPA_PARAM_Latency, 0, std::numeric_limits<std::uint32_t>::max(), nullptr);
+
+            co_await sync();
+            spa_hook_remove(&query.listener);
         }
 
-        if (virt_mic.has_value() && virt_mic->loopback_receiver.id() == node.id)
+        co_return query.upstream;
+    }
+
+    bool patchbay::impl::should_link(std::uint32_t id, const node_entry &node)
+    {
+        const auto scope = span{"should_link"};
+
+        if (!options.has_value())
+        {
+            return false;
+        }
+
+        if (const auto it = decisions.find(id); it != decisions.end())
+        {
+            logger::get()(trace, "[patchbay] (should_link) using cached result for {}", id);
+            return it->second;
+        }
+
+        const auto start  = std::chrono::steady_clock::now();
+        const auto result = decide(id, node);
+
+        stats.should_link.observe(std::chrono::steady_clock::now() - start);
+        stats.evaluations.fetch_add(1, std::memory_order_relaxed);
+        stats.acceptances.fetch_add(result, std::memory_order_relaxed);
+
+        recorder::get()(result ? recorder::event::link_accepted : recorder::event::link_rejected, id);
+
+        return decisions[id] = result;
+    }
+
+    bool patchbay::impl::decide(std::uint32_t id, const node_entry &node)
+    {
+        logger::get()(debug, "[patchbay] (should_link) checking {}", id);
+
+        const auto &props = node.props;
+
+        // Covers the sharing nodes, loopbacks, meter and capture, including ones of another venmic instance
+        if (owned(props))
+        {
+            logger::get()(debug, "[patchbay] (should_link) └ is owned by venmic", id);
+            return false;
+        }
+
+        if (!rules.include.empty() && !rules.include.matches(props))
+        {
+            logger::get()(debug, "[patchbay] (should_link) └ did not match include criteria", id);
+            return false;
+        }
+
+        if (rules.exclude.matches(props))
+        {
+            logger::get()(debug, "[patchbay] (should_link) └ matched exclude criteria", id);
+            return false;
+        }
+
+        if (ports_of(id).empty())
         {
-            logger::get()(debug, "[patchbay] (should_link) └ is the virt-mic-receiver", node.id);
+            logger::get()(debug, "[patchbay] (should_link) └ has no ports", id);
             return false;
         }
 
-        if (options->ignore_devices && !props["device.id"].empty())
+        if (options->ignore_devices && !props["device.id"].empty())
+        {
+            logger::get()(debug, "[patchbay] (should_link) └ is a device", id);
+            return false;
+        }
+
+        const auto is_device = [this](const auto &item)
+        {
+            const auto target = nodes.find(item.first);
+            return target != nodes.end() && target->second.props.contains("device.id");
+        };
+
+        if (options->only_speakers && !std::ranges::any_of(edges.outputs(id), is_device))
+        {
+            logger::get()(debug, "[patchbay] (should_link) └ does not link to speakers", id);
+            return false;
+        }
+
+        const auto speakers_known = default_speaker.has_value() && default_speaker->id.has_value();
+
+        if (options->only_default_speakers && !speakers_known)
+        {
+            logger::get()(debug, "[patchbay] (should_link) └ default speakers are unknown", id);
+            return false;
+        }
+
+        if (options->only_default_speakers && !edges.feeds(id, *default_speaker->id))
+        {
+            logger::get()(debug, "[patchbay] (should_link) └ does not link to default speakers", id);
+            return false;
+        }
+
+        logger::get()(debug, "[patchbay] (should_link) └ accepted!");
+
+        return true;
+    }
+
+    void patchbay::impl::invalidate(std::uint32_t id)
+    {
+        decisions.erase(id);
+
+        // Nodes playing to this one depend on whether it is a device
+        for (const auto &peer : edges.inputs(id) | std::views::keys)
+        {
+            decisions.erase(peer);
+        }
+    }
+
+    void patchbay::impl::link(std::uint32_t from, std::uint32_t to)
+    {
+        const auto scope = span{"link"};
+
+        const auto mixing = virt_mic.has_value() && virt_mic->mixer;
+        auto ports        = !mixing && options->direct ? route(from, to) : port_pairs{};
+        auto existing     = virt_links.find(from);
+
+        if (existing != virt_links.end())
+        {
+            const auto &current = existing->second.route;
+            const auto reusable = mixing ? static_cast<bool>(current.input) : !current.input && current.ports == ports;
+
+            if (existing->second.target == to && (reusable || existing->second.gated))
+            {
+                logger::get()(trace, "[patchbay] (link) keeping existing link {} -> {}", from, to);
+            }
+            else
+            {
+                virt_links.erase(existing);
+                existing = virt_links.end();
+            }
+        }
+
+        const auto conversion = existing == virt_links.end() ? report(from, to) : std::string{};
+
+        if (existing == virt_links.end() && mixing)
+        {
+            virt_links.emplace(from, virt_link{.target = to, .conversion = conversion});
+            logger::get()(info, "[patchbay] (link) mixing {} into {}", from, to);
+            recorder::get()(recorder::event::mixed, from, to);
+        }
+        else if (existing == virt_links.end() && !ports.empty())
+        {
+            virt_links.emplace(from, virt_link{.target = to, .conversion = conversion, .route = {.ports = ports}});
+            logger::get()(info, "[patchbay] (link) routing {} -> {} directly ({} port(s))", from, to, ports.size());
+            recorder::get()(recorder::event::routed, from, to, ports.size());
+
+            connect(from, &virt_link::route, std::move(ports));
+        }
+        else if (existing == virt_links.end())
+        {
+            if (options->direct)
+            {
+                logger::get()(debug, "[patchbay] (link) ports of {} do not match {}, falling back to loopback", from, to);
+            }
+
+            const auto capture  = std::format("venmic-loopback-capture-{}-{}", from, to);
+            const auto playback = std::format("venmic-loopback-playback-{}-{}", from, to);
+
+            // Both streams carry the requested latency too, so that it applies to the whole path and not only the null nodes
+            const auto serial = [this](std::uint32_t id)
+            {
+                const auto node = nodes.find(id);
+                return node != nodes.end() ? std::string{node->second.props["object.serial"]} : std::to_string(id);
+            };
+
+            const auto latency = latency_of({.rate = virt_mic->format.rate, .latency = options->latency});
+            const auto args    = loopback_args(capture, serial(from), playback, serial(to), latency);
+
+            auto loaded = context->load("libpipewire-module-loopback", args);
+
+            if (!loaded.has_value())
+            {
+                recorder::get()(recorder::event::loopback_failed, from, to);
+                return logger::get()(warn, "[patchbay] (link) failed to create loopback ({} -> {}): {}", from, to,
+                                     loaded.error().message());
+            }
+
+            auto module        = loopback{std::move(*loaded), {nullptr, &stats.loopbacks_destroyed}};
+            const auto created = stats.loopbacks_created.fetch_add(1, std::memory_order_relaxed) + 1;
+
+            virt_links.emplace(from, virt_link{.target = to, .module = std::move(module), .conversion = conversion});
+
+            logger::get()(info, "[patchbay] (link) created loopback {} -> {} ({} created so far)", from, to, created);
+            recorder::get()(recorder::event::loopback_created, from, to, created);
+        }
+
+        if (mixing && !virt_links.at(from).gated)
+        {
+            attach(from, *virt_mic->mixer, &virt_link::route);
+        }
+
+        if (meters)
+        {
+            attach(from, *meters, &virt_link::meter);
+        }
+    }
+
+    void patchbay::impl::attach(std::uint32_t from, mix_node &node, tap virt_link::*member)
+    {
+        auto &state   = virt_links.at(from).*member;
+        const auto to = node.id().value_or(0);
+
+        if (!state.input)
+        {
+            state.input = node.add(from);
+            return feed(from, to, member);
+        }
+
+        auto ports = route(from, to, mix_node::group(from), mapping::stereo);
+
+        if (ports.empty() || state.ports == ports)
+        {
+            logger::get()(trace, "[patchbay] (attach) keeping existing input of {} on {}", from, to);
+            return;
+        }
+
+        state.links.clear();
+        state.ports = ports;
+
+        connect(from, member, std::move(ports));
+    }
+
+    coco::stray patchbay::impl::feed(std::uint32_t from, std::uint32_t to, tap virt_link::*member)
+    {
+        const auto group = mix_node::group(from);
+
+        // The ports of a new input group only become known once the server announced them
+        for (auto attempt = 0; attempt < 50; ++attempt)
+        {
+            co_await sync();
+
+            const auto entry = virt_links.find(from);
+
+            if (entry == virt_links.end() || !(entry->second.*member).input)
+            {
+                co_return;
+            }
+
+            auto &state = entry->second.*member;
+            auto ports  = route(from, to, group, mapping::stereo);
+
+            if (ports.empty())
+            {
+                continue;
+            }
+
+            if (state.ports == ports)
+            {
+                co_return;
+            }
+
+            state.links.clear();
+            state.ports = ports;
+
+            co_return connect(from, member, std::move(ports));
+        }
+
+        logger::get()(warn, "[patchbay] (feed) could not route {} into {}, channels may not match", from, to);
+    }
+
+    coco::stray patchbay::impl::connect(std::uint32_t from, tap virt_link::*member, port_pairs ports)
+    {
+        for (const auto &[output, input] : ports)
+        {
+            auto link = co_await core->create(pw::link_factory{
+                .input  = input,
+                .output = output,
+            });
+
+            if (!link.has_value())
+            {
+                logger::get()(warn, "[patchbay] (connect) could not create link ({} -> {}): {}", output, input,
+                              link.error().message);
+                continue;
+            }
+
+            const auto entry = virt_links.find(from);
+
+            if (entry == virt_links.end() || (entry->second.*member).ports != ports)
+            {
+                logger::get()(debug, "[patchbay] (connect) route of {} changed while linking, dropping link", from);
+                co_return;
+            }
+
+            if (member == &virt_link::route && entry->second.gated)
+            {
+                logger::get()(debug, "[patchbay] (connect) {} was gated while linking, dropping link", from);
+                co_return;
+            }
+
+            (entry->second.*member).links.emplace_back(std::move(*link));
+        }
+    }
+
+    port_pairs patchbay::impl::route(std::uint32_t from, std::uint32_t to, std::string_view group, mapping mode)
+    {
+        static const auto is_output = [](const auto &info)
+        {
+            return info.direction == pw::port_direction::output;
+        };
+        const auto is_input = [group](const auto &info)
+        {
+            return info.direction == pw::port_direction::input && (group.empty() || info.props["port.group"] == group);
+        };
+
+        auto candidates = ports_of(to) | std::views::values | std::views::filter(is_input);
+        auto outputs    = ports_of(from) | std::views::values | std::views::filter(is_output);
+        auto rtn        = port_pairs{};
+
+        const auto count = static_cast<std::size_t>(std::ranges::distance(outputs));
+        auto index       = 0uz;
+
+        for (const auto &port : outputs)
+        {
+            const auto channel = port.props["audio.channel"];
+            const auto targets = mode == mapping::stereo ? fold(channel, index++, count) : std::vector{channel};
+
+            for (const auto &target : targets)
+            {
+                const auto matching = [&target](const auto &item)
+                {
+                    return item.props["audio.channel"] == target;
+                };
+
+                const auto match = std::ranges::find_if(candidates, matching);
+
+                if (mode == mapping::exact && (channel.empty() || match == candidates.end()))
+                {
+                    // A single unmatched channel means the formats differ, only a loopback can convert them
+                    return {};
+                }
+
+                if (match == candidates.end())
+                {
+                    continue;
+                }
+
+                rtn.emplace_back(port.id, match->id);
+            }
+        }
+
+        return rtn;
+    }
+
+    std::string patchbay::impl::report(std::uint32_t from, std::uint32_t to)
+    {
+        const auto source = format_of(from, pw::port_direction::output);
+        const auto target = virt_mic->mixer ? audio_format{.positions = {"FL", "FR"}} : virt_mic->format;
+
+        const auto missing = [&target](const auto &channel)
+        {
+            return !std::ranges::contains(target.positions, channel);
+        };
+
+        const auto remixing   = source.positions.size() != target.positions.size() || //
+                              std::ranges::any_of(source.positions, missing);
+        const auto resampling = source.rate > 0 && target.rate > 0 && source.rate != target.rate;
+
+        auto rtn = std::vector<std::string>{};
+
+        if (!remixing && !resampling)
+        {
+            logger::get()(debug, "[patchbay] (report) {} -> {} needs no conversion", from, to);
+        }
+
+        if (remixing)
+        {
+            logger::get()("[patchbay] (report) {} -> {} remixes {} into {} channel(s)", from, to, source.positions.size(),
+                          target.positions.size());
+            rtn.emplace_back(std::format("remix {} -> {}", source.positions.size(), target.positions.size()));
+        }
+
+        if (resampling)
+        {
+            logger::get()("[patchbay] (report) {} -> {} resamples {} Hz to {} Hz", from, to, source.rate, target.rate);
+            rtn.emplace_back(std::format("resample {} -> {}", source.rate, target.rate));
+        }
+
+        return rtn | std::views::join_with(std::string_view{", "}) | std::ranges::to<std::string>();
+    }
+
+    coco::stray patchbay::impl::pause(std::uint32_t id, bool paused)
+    {
+        const auto entry = virt_links.find(id);
+
+        if (entry == virt_links.end())
+        {
+            co_return;
+        }
+
+        auto &link = entry->second;
+
+        if (paused)
+        {
+            link.route.links.clear();
+            co_return;
+        }
+
+        // Mixer inputs whose ports were not announced yet are fed once they are
+        if (link.route.ports.empty() && virt_mic.has_value() && virt_mic->mixer)
+        {
+            co_return attach(id, *virt_mic->mixer, &virt_link::route);
+        }
+
+        connect(id, &virt_link::route, link.route.ports);
+    }
+
+    void patchbay::impl::update_gates()
+    {
+        const auto scope = span{"update_gates"};
+
+        if (!options.has_value() || !options->gate || !virt_mic.has_value())
+        {
+            return;
+        }
+
+        const auto now  = std::chrono::steady_clock::now();
+        const auto hold = std::chrono::milliseconds{options->gate};
+
+        auto peaks = std::unordered_map<std::uint32_t, float>{};
+
+        // The held peaks cover every quantum since the last check, so short bursts are not mistaken for silence
+        for (const auto &item : levels->drain())
+        {
+            peaks[item.node] = std::ranges::max(item.peak);
+        }
+
+        auto resumed = std::vector<std::uint32_t>{};
+        auto changed = false;
+
+        for (auto &[id, entry] : virt_links)
+        {
+            // Muting a loopback would leave it processing, so only direct routes and mixer inputs are gated
+            if (entry.module.has_value())
+            {
+                continue;
+            }
+
+            const auto peak = peaks.find(id);
+
+            // Nodes that are not measured are never gated
+            const auto audible = peak == peaks.end() || peak->second > silence;
+
+            if (audible)
+            {
+                entry.heard = now;
+            }
+
+            if (entry.gated && audible)
+            {
+                resumed.emplace_back(id);
+                continue;
+            }
+
+            if (entry.gated || now - entry.heard < hold)
+            {
+                continue;
+            }
+
+            // The meter tap stays linked, so that we notice once the node becomes audible again
+            entry.gated = tally{&stats.gated};
+            changed     = true;
+
+            pause(id, true);
+
+            logger::get()(debug, "[patchbay] (gate) {} is silent, paused capturing it", id);
+            recorder::get()(recorder::event::gated, id);
+        }
+
+        for (const auto &id : resumed)
+        {
+            virt_links.at(id).gated = {};
+            pause(id, false);
+
+            logger::get()(debug, "[patchbay] (gate) {} is audible again, resumed capturing it", id);
+            recorder::get()(recorder::event::ungated, id);
+        }
+
+        if (!changed && resumed.empty())
+        {
+            return;
+        }
+
+        publish();
+    }
+
+    const std::map<std::uint32_t, port_entry> &patchbay::impl::ports_of(std::uint32_t id)
+    {
+        static const auto empty = std::map<std::uint32_t, port_entry>{};
+
+        if (const auto it = node_ports.find(id); it != node_ports.end())
+        {
+            return it->second;
+        }
+
+        return empty;
+    }
+
+    audio_format patchbay::impl::format_of(std::uint32_t id, pw::port_direction direction)
+    {
+        auto rtn = audio_format{};
+
+        for (const auto &port : ports_of(id) | std::views::values)
+        {
+            if (const auto channel = port.props["audio.channel"]; port.direction == direction && !channel.empty())
+            {
+                rtn.positions.emplace_back(channel);
+            }
+        }
+
+        if (const auto node = nodes.find(id); node != nodes.end())
+        {
+            rtn.rate = rate_of(node->second.props);
+        }
+
+        return rtn;
+    }
+
+    audio_format patchbay::impl::resolve(audio_format requested)
+    {
+        // A rate of 0 is left to the graph, so that the sharing node never forces a resampling pass by itself
+        if (!requested.positions.empty())
+        {
+            return requested;
+        }
+
+        const auto speaker = default_speaker.and_then([](const auto &item) { return item.id; });
+        const auto playing = speaker ? format_of(*speaker, pw::port_direction::input) : audio_format{};
+
+        requested.positions = playing.positions.empty() ? std::vector<std::string>{"FL", "FR"} : playing.positions;
+
+        logger::get()(debug, "[patchbay] (resolve) using {} channel(s) of speaker {}", requested.positions.size(),
+                      speaker.value_or(0));
+
+        return requested;
+    }
+
+    std::optional<std::uint32_t> patchbay::impl::find_matching(const matcher &workaround, const std::vector<node> &targets)
+    {
+        const auto matching = [this, &workaround](auto id)
+        {
+            const auto node = nodes.find(id);
+            return node != nodes.end() && workaround.matches(node->second.props);
+        };
+
+        const auto exact = [this](const auto &prop) -> std::optional<std::string>
+        {
+            auto value = prop.second;
+
+            if (!index.indexed(prop.first) || pattern::parse(value).has_value())
+            {
+                return std::nullopt;
+            }
+
+            return value;
+        };
+
+        for (const auto &target : targets)
+        {
+            auto indexed = std::optional<std::pair<std::string, std::string>>{};
+
+            for (const auto &prop : target)
+            {
+                if (auto value = exact(prop); value.has_value())
+                {
+                    indexed.emplace(prop.first, std::move(*value));
+                    break;
+                }
+            }
+
+            if (!indexed.has_value())
+            {
+                // No exact property of this target is indexed, we have to fall back to a full scan
+                const auto node = std::ranges::find_if(nodes, matching, [](const auto &item) { return item.first; });
+
+                if (node == nodes.end())
+                {
+                    return std::nullopt;
+                }
+
+                return node->first;
+            }
+
+            const auto &candidates = index.find(indexed->first, indexed->second);
+
+            if (const auto node = std::ranges::find_if(candidates, matching); node != candidates.end())
+            {
+                return *node;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    template <>
+    coco::stray patchbay::impl::handle(pw::node node)
+    {
+        const auto scope = span{"handle<node>"};
+
+        const auto id = node.id();
+        auto info     = node.info();
+        auto props    = info.props;
+
+        recorder::get()(recorder::event::node_added, id);
+
+        logger::get()(debug, "[patchbay] (handle) new node: {}", id);
+        logger::get()(debug, "[patchbay] (handle) ├ node.name: {}", props["node.name"]);
+        logger::get()(debug, "[patchbay] (handle) ├ application.name: {}", props["application.name"]);
+        logger::get()(debug, "[patchbay] (handle) └ application.process.binary: {}", props["application.process.binary"]);
+
+        if (const auto existing = nodes.find(id); existing != nodes.end())
+        {
+            index.remove(id, existing->second.props);
+        }
+
+        auto entry = node_entry{
+            .props      = {strings, info.props},
+            .can_output = info.output.max > 0,
+        };
+
+        index.add(id, entry.props);
+
+        if (profiling && owned(entry.props))
+        {
+            profiling->track(id, std::string{entry.props["node.name"]});
+        }
+
+        nodes.insert_or_assign(id, std::move(entry));
+        invalidate(id);
+
+        if (default_speaker.has_value() && index.find("node.name", default_speaker->name).contains(id))
+        {
+            if (default_speaker->id != id)
+            {
+                decisions.clear();
+            }
+
+            default_speaker->id = id;
+            logger::get()("[patchbay] (handle) found node for default speaker: {}", id);
+        }
+
+        co_return schedule(id);
+    }
+
+    template <>
+    coco::stray patchbay::impl::handle(pw::port port)
+    {
+        const auto scope = span{"handle<port>"};
+
+        const auto id = port.id();
+        auto info     = port.info();
+        auto props    = info.props;
+
+        auto raw_parent = props["node.id"];
+        auto parent     = std::uint32_t{};
+
+        logger::get()(trace, "[patchbay] (handle) new port: {}", id);
+        logger::get()(trace, "[patchbay] (handle) └ parent: {}", raw_parent);
+
+        if (std::from_chars(raw_parent.data(), raw_parent.data() + raw_parent.size(), parent).ec != std::errc{})
+        {
+            co_return logger::get()(trace, "[patchbay] (handle) could not parse parent of {} (\"{}\")", id, raw_parent);
+        }
+
+        recorder::get()(recorder::event::port_added, id, parent);
+
+        auto &siblings = node_ports[parent];
+
+        if (siblings.empty())
+        {
+            decisions.erase(parent);
+        }
+
+        auto entry = port_entry{
+            .id        = id,
+            .props     = {strings, info.props},
+            .direction = info.direction,
+        };
+
+        ports[id] = parent;
+        siblings.insert_or_assign(id, std::move(entry));
+
+        co_return schedule(parent);
+    }
+
+    template <>
+    coco::stray patchbay::impl::handle(pw::link link)
+    {
+        const auto scope = span{"handle<link>"};
+
+        const auto id = link.id();
+        auto info     = link.info();
+        auto props    = info.props;
+
+        recorder::get()(recorder::event::link_added, id, info.output.node, info.output.port, info.input.node,
+                        info.input.port);
+
+        logger::get()(trace, "[patchbay] (handle) new link: {}", id);
+        logger::get()(trace, "[patchbay] (handle) ├ from: {} (port: {})", info.output.node, info.output.port);
+        logger::get()(trace, "[patchbay] (handle) └ to: {} (port: {})", info.input.node, info.input.port);
+
+        const auto from = info.output.node;
+        const auto to   = info.input.node;
+
+        links[id] = link_entry{.from = from, .to = to};
+
+        if (edges.add(from, to))
+        {
+            decisions.erase(from);
+        }
+
+        if (!virt_mic.has_value())
+        {
+            co_return;
+        }
+
+        if (virt_links.contains(from) || virt_links.contains(to))
+        {
+            co_return;
+        }
+
+        schedule(from);
+        schedule(to);
+
+        logger::get()(debug, "[patchbay] (handle) scheduled nodes ({} -> {}) attached to {}", from, to, id);
+    }
+
+    struct pw_metadata_name // NOLINT(*-internal-linkage)
+    {
+        std::string name;
+    };
+
+    template <>
+    coco::stray patchbay::impl::handle(pw::metadata metadata)
+    {
+        const auto scope = span{"handle<metadata>"};
+
+        auto info  = metadata.properties();
+        auto props = metadata.props();
+
+        const auto id   = metadata.id();
+        const auto name = props["metadata.name"];
+
+        recorder::get()(recorder::event::metadata_added, id);
+
+        logger::get()(debug, "[patchbay] (handle) new metadata: {}", id);
+        logger::get()(debug, "[patchbay] (handle) └ name: {}", name);
+
+        if (name == "settings")
+        {
+            auto *const raw = metadata.get();
+            settings.emplace(std::move(metadata), raw);
+
+            const auto update = [this](const char *raw, pw::metadata_property prop)
+            {
+                if (raw && std::string_view{raw}.starts_with("clock."))
+                {
+                    clock.insert_or_assign(raw, prop.value);
+                }
+
+                return 0;
+            };
+
+            settings->listener.on<pw::metadata_event::property>(update);
+
+            for (const auto &key : {"clock.rate", "clock.quantum", "clock.force-quantum"})
+            {
+                update(key, info[key]);
+            }
+
+            co_return;
+        }
+
+        if (name != "default")
+        {
+            co_return;
+        }
+
+        auto *const raw = metadata.get();
+        meta.emplace(std::move(metadata), raw);
+
+        const auto update = [this](const char *raw, pw::metadata_property prop)
+        {
+            if (!raw)
+            {
+                return 0;
+            }
+
+            const auto key = std::string_view{raw};
+
+            if (key != "default.audio.sink")
+            {
+                return 0;
+            }
+
+            const auto parsed = glz::read_json<pw_metadata_name>(prop.value);
+
+            if (!parsed.has_value())
+            {
+                logger::get()(warn, "[patchbay] (meta) failed to parse speaker");
+                return 0;
+            }
+
+            const auto &candidates = index.find("node.name", parsed->name);
+            const auto previous    = default_speaker.and_then([](const auto &item) { return item.id; });
+
+            default_speaker = speaker{
+                .name = parsed->name,
+            };
+
+            if (!candidates.empty())
+            {
+                default_speaker->id = *candidates.begin();
+            }
+
+            if (default_speaker->id != previous)
+            {
+                decisions.clear();
+            }
+
+            logger::get()("[patchbay] (meta) found default speaker: {}", parsed->name);
+            logger::get()("[patchbay] (meta) └ node: {}",
+                          candidates.empty() ? "<pending>" : std::to_string(*candidates.begin()));
+
+            return 0;
+        };
+
+        meta->listener.on<pw::metadata_event::property>(update);
+        update("default.audio.sink", info["default.audio.sink"]);
+
+        co_return co_await redirect();
+    }
+
+    void patchbay::impl::schedule(std::uint32_t id)
+    {
+        stats.scheduled.fetch_add(1, std::memory_order_relaxed);
+        pending.emplace(id);
+
+        if (std::exchange(flushing, true))
+        {
+            return;
+        }
+
+        if (flush_timer)
+        {
+            arm(loop->get(), flush_timer, flush_timeout, false);
+        }
+
+        flush();
+    }
+
+    coco::stray patchbay::impl::flush()
+    {
+        const auto current = flushes;
+
+        // Let the burst of globals that is currently being announced settle before evaluating anything
+        co_await sync();
+
+        // The deadline may have evaluated this batch already, a new one is left to its own sync
+        if (!flushing || flushes != current)
+        {
+            co_return;
+        }
+
+        evaluate();
+    }
+
+    coco::stray patchbay::impl::evaluate()
+    {
+        const auto scope = span{"evaluate"};
+
+        if (flush_timer)
+        {
+            arm(loop->get(), flush_timer, 0ns);
+        }
+
+        const auto targets = std::exchange(pending, {});
+
+        flushing = false;
+        ++flushes;
+
+        for (const auto &id : targets)
+        {
+            const auto node = nodes.find(id);
+
+            if (node == nodes.end())
+            {
+                continue;
+            }
+
+            stats.evaluated.fetch_add(1, std::memory_order_relaxed);
+
+            if (virt_mic.has_value() && should_link(id, node->second))
+            {
+                link(id, virt_mic->loopback_receiver.id());
+            }
+        }
+
+        for (const auto &id : targets)
+        {
+            co_await redirect(id);
+        }
+
+        publish();
+
+        recorder::get()(recorder::event::flushed, targets.size());
+
+        const auto scheduled = stats.scheduled.load(std::memory_order_relaxed);
+        const auto evaluated = stats.evaluated.load(std::memory_order_relaxed);
+
+        logger::get()(debug, "[patchbay] (flush) evaluated {} node(s)", targets.size());
+        logger::get()(debug, "[patchbay] (flush) └ saved {} of {} evaluations so far ({} dropped before evaluation)",
+                      scheduled - evaluated, scheduled, stats.dropped.load(std::memory_order_relaxed));
+    }
+
+    void patchbay::impl::add_global(pw::global global)
+    {
+        const auto scope = span{"add_global"};
+
+        const auto forward = []<typename T>(auto self, auto global, std::type_identity<T>) -> coco::stray
+        {
+            auto bound = co_await self->registry->template bind<T>(global.id);
+
+            if (bound.has_value())
+            {
+                self->handle(std::move(*bound));
+                co_return;
+            }
+
+            logger::get()(warn, "[patchbay] (add_global) failed to bind {}: {}", global.id, bound.error().message);
+        };
+
+        logger::get()(trace, "[patchbay] (add_global) new global {}: {}", global.id, global.type);
+
+        if (global.type == pw::node::type)
+        {
+            stats.count(statistics::event::node);
+            forward(this, std::move(global), std::type_identity<pw::node>{});
+        }
+        else if (global.type == pw::port::type)
+        {
+            stats.count(statistics::event::port);
+            forward(this, std::move(global), std::type_identity<pw::port>{});
+        }
+        else if (global.type == pw::link::type)
+        {
+            stats.count(statistics::event::link);
+            forward(this, std::move(global), std::type_identity<pw::link>{});
+        }
+        else if (global.type == pw::metadata::type)
+        {
+            stats.count(statistics::event::metadata);
+            forward(this, std::move(global), std::type_identity<pw::metadata>{});
+        }
+        else if (global.type == PW_TYPE_INTERFACE_Profiler && !profiler_id)
+        {
+            // Profiling makes the server send data for every cycle, so it is only bound once telemetry is requested
+            profiler_id = global.id;
+        }
+    }
+
+    void patchbay::impl::release_profiler()
+    {
+        if (!profiling)
+        {
+            return;
+        }
+
+        logger::get()(debug, "[patchbay] (release_profiler) releasing unused profiler");
+
+        profiling.reset();
+
+        if (profile_timer)
+        {
+            arm(loop->get(), profile_timer, 0ns);
+        }
+    }
+
+    void patchbay::impl::del_global(std::uint32_t id)
+    {
+        const auto scope = span{"del_global"};
+
+        virt_links.erase(id);
+
+        if (profiling)
+        {
+            profiling->untrack(id);
+        }
+
+        if (profiler_id == id)
+        {
+            profiler_id.reset();
+            release_profiler();
+        }
+
+        if (pending.erase(id))
+        {
+            stats.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (const auto node = nodes.find(id); node != nodes.end())
+        {
+            invalidate(id);
+            index.remove(id, node->second.props);
+            nodes.erase(node);
+        }
+
+        if (const auto link = links.find(id); link != links.end())
+        {
+            if (edges.remove(link->second.from, link->second.to))
+            {
+                decisions.erase(link->second.from);
+            }
+
+            links.erase(link);
+        }
+
+        if (const auto port = ports.find(id); port != ports.end())
+        {
+            auto &siblings = node_ports[port->second];
+            siblings.erase(id);
+
+            if (siblings.empty())
+            {
+                decisions.erase(port->second);
+                node_ports.erase(port->second);
+            }
+
+            ports.erase(port);
+        }
+
+        stats.count(statistics::event::removed);
+        publish();
+
+        logger::get()(trace, "[patchbay] (del_global) removed global {}", id);
+        recorder::get()(recorder::event::global_removed, id);
+    }
+
+    template <>
+    coco::stray patchbay::impl::receive(cr_recipe::sender, vencord::link_options opts)
+    {
+        const auto scope = span{"receive<link_options>"};
+
+        const auto duplex = opts.duplex && !opts.mixer;
+        auto requested    = audio_format{.latency = opts.latency};
+
+        if (!opts.mixer)
         {
-            logger::get()(debug, "[patchbay] (should_link) └ is a device", node.id);
-            return false;
+            requested.positions = opts.positions;
+            requested.rate      = opts.rate;
         }
 
-        const auto outputs = [](const auto &item)
+        if (virt_mic.has_value() && (static_cast<bool>(virt_mic->mixer) != opts.mixer || virt_mic->duplex != duplex))
         {
-            return item.second.input.node;
-        };
+            logger::get()("[patchbay] (receive) sharing mode changed, recreating sharing setup");
+            cleanup(clean::with_mic);
+        }
 
-        const auto exists = [this](const auto &id)
+        // Only an explicit change recreates the nodes, a format that followed the speaker stays as long as they live
+        if (virt_mic.has_value() && virt_mic->requested != requested)
         {
-            return nodes.contains(id);
-        };
+            logger::get()("[patchbay] (receive) sharing format changed, recreating sharing setup");
+            cleanup(clean::with_mic);
+        }
 
-        const auto info = [this](const auto &id)
+        // The null nodes only take their latency when they are created, unlike the mixer which updates it in place
+        if (virt_mic.has_value() && !virt_mic->mixer && virt_mic->requested.latency != requested.latency)
         {
-            return nodes[id];
-        };
+            logger::get()("[patchbay] (receive) latency changed to {}, recreating sharing setup", requested.latency);
+            cleanup(clean::with_mic);
+        }
 
-        const auto links   = links_of(node);
-        const auto targets = links                            //
-                             | std::views::transform(outputs) //
-                             | std::views::filter(exists)     //
-                             | std::views::transform(info)    //
-                             | std::ranges::to<std::vector>();
+        const auto existing = virt_mic.has_value(); // Nodes created below already carry the requested latency
 
-        const auto is_device = [](const auto &item)
+        if (!virt_mic.has_value() && opts.mixer)
         {
-            return item.props.contains("device.id");
-        };
-
-        if (options->only_speakers && !std::ranges::any_of(targets, is_device))
+            co_await create_mixer(opts.mute, requested);
+        }
+        else if (!virt_mic.has_value() && duplex)
         {
-            logger::get()(debug, "[patchbay] (should_link) └ does not link to speakers", node.id);
-            return false;
+            co_await create_source(opts.mute, resolve(requested));
         }
-
-        const auto speakers_known = default_speaker.has_value() && default_speaker->id.has_value();
-
-        if (options->only_default_speakers && !speakers_known)
+        else if (!virt_mic.has_value())
         {
-            logger::get()(debug, "[patchbay] (should_link) └ default speakers are unknown", node.id);
-            return false;
+            co_await create_mic(opts.mute, resolve(requested));
         }
 
-        const auto extract_id = [](auto &&item)
+        if (existing && virt_mic->requested.latency != requested.latency)
         {
-            return item.id;
-        };
+            logger::get()("[patchbay] (receive) latency changed to {}, applying it to the mixer", requested.latency);
+
+            virt_mic->format.latency = requested.latency;
+            virt_mic->mixer->latency(latency_of(virt_mic->format));
+
+            // Loopbacks are loaded with the latency as argument, they are recreated with the new one when relinked below
+            std::erase_if(virt_links, [](const auto &item) { return item.second.module.has_value(); });
+        }
 
-        if (options->only_default_speakers && !std::ranges::contains(targets, default_speaker->id, extract_id))
+        if (virt_mic.has_value())
         {
-            logger::get()(debug, "[patchbay] (should_link) └ does not link to default speakers", node.id);
-            return false;
+            virt_mic->requested = requested;
         }
 
-        logger::get()(debug, "[patchbay] (should_link) └ accepted!");
+        cleanup(clean::without_mic);
 
-        return true;
-    }
+        rules = {
+            .include    = opts.include,
+            .exclude    = opts.exclude,
+            .workaround = opts.workaround,
+        };
+        options.emplace(std::move(opts));
 
-    void patchbay::impl::link(const pw::node_info &from, const pw::node_info &to)
-    {
-        if (virt_links.contains(from.id))
+        force_quantum(options->force_quantum && options->latency > 0 ? std::optional{options->latency} : std::nullopt);
+
+        if (gate_timer)
         {
-            virt_links.erase(from.id);
+            arm(loop->get(), gate_timer, options->gate > 0 ? std::chrono::nanoseconds{gate_interval} : 0ns);
         }
 
-        const auto capture  = std::format("venmic-loopback-capture-{}-{}", from.id, to.id);
-        const auto playback = std::format("venmic-loopback-playback-{}-{}", from.id, to.id);
-
-        auto loopback = context->load(pw::loopback_options{
-            .capture =
-                {
-                    .name        = capture,
-                    .description = capture,
-                    .node        = from.id,
-                },
-            .playback =
-                {
-                    .name        = playback,
-                    .description = playback,
-                    .node        = to.id,
-                },
-        });
-
-        if (!loopback.has_value())
+        if (!options->gate)
         {
-            return logger::get()(warn, "[patchbay] (link) failed to create loopback ({} -> {}): {}", from.id, to.id,
-                                 loopback.error().message());
+            for (auto &[id, entry] : virt_links)
+            {
+                if (entry.gated)
+                {
+                    entry.gated = {};
+                    pause(id, false);
+                }
+            }
         }
 
-        virt_links.emplace(from.id, std::move(*loopback));
+        // The mixer already sees every source, so it measures them itself, unless their inputs may be gated
+        const auto self_metering = virt_mic.has_value() && virt_mic->mixer && !options->gate;
+        const auto metering      = (options->meter || options->gate > 0) && !self_metering;
 
-        logger::get()(info, "[patchbay] (link) created loopback {} -> {}", from.id, to.id);
-    }
+        if (virt_mic.has_value() && virt_mic->mixer)
+        {
+            virt_mic->mixer->meter(options->meter && self_metering ? levels : nullptr);
+        }
 
-    std::map<std::uint32_t, pw::port_info> patchbay::impl::ports_of(const pw::node_info &info)
-    {
-        const auto node   = std::format("{}", info.id);
-        const auto filter = [node](const auto &item)
+        if (metering && !meters)
         {
-            auto props = item.second.props;
-            return props["node.id"] == node;
-        };
+            co_await create_meter();
+        }
+        else if (!metering && meters)
+        {
+            for (auto &entry : virt_links | std::views::values)
+            {
+                entry.meter = {};
+            }
 
-        return ports                        //
-               | std::views::filter(filter) //
-               | std::ranges::to<std::map>();
-    }
+            meters.reset();
+        }
 
-    std::map<std::uint32_t, pw::link_info> patchbay::impl::links_of(const pw::node_info &info)
-    {
-        const auto filter = [&info](const auto &item)
+        co_await sync();
+
+        const auto linkable = [this](const auto &item)
         {
-            return item.second.input.node == info.id || item.second.output.node == info.id;
+            return should_link(item.first, item.second);
         };
 
-        return links                        //
-               | std::views::filter(filter) //
-               | std::ranges::to<std::map>();
-    }
-
-    template <>
-    coco::stray patchbay::impl::handle(pw::node node)
-    {
-        const auto id = node.id();
-        auto info     = node.info();
-        auto props    = info.props;
+        const auto targets = nodes                          //
+                             | std::views::filter(linkable) //
+                             | std::views::keys             //
+                             | std::ranges::to<std::unordered_set>();
 
-        logger::get()(debug, "[patchbay] (handle) new node: {}", id);
-        logger::get()(debug, "[patchbay] (handle) ├ node.name: {}", props["node.name"]);
-        logger::get()(debug, "[patchbay] (handle) ├ application.name: {}", props["application.name"]);
-        logger::get()(debug, "[patchbay] (handle) └ application.process.binary: {}", props["application.process.binary"]);
+        const auto stale = std::erase_if(virt_links, [&targets](const auto &item) { return !targets.contains(item.first); });
 
-        if (default_speaker.has_value() && default_speaker->name == props["node.name"])
+        for (const auto &id : targets)
         {
-            default_speaker->id = id;
-            logger::get()("[patchbay] (handle) found node for default speaker: {}", id);
+            link(id, virt_mic->loopback_receiver.id());
         }
 
-        if (virt_mic.has_value() && should_link(info))
-        {
-            link(info, virt_mic->loopback_receiver.info());
-        }
+        logger::get()(debug, "[patchbay] (receive) relinked with {} target(s), removed {} stale loopback(s)", targets.size(),
+                      stale);
+        recorder::get()(recorder::event::relinked, targets.size(), stale);
 
-        co_await redirect(info);
+        publish();
 
-        nodes[id] = std::move(info);
+        co_await redirect();
     }
 
     template <>
-    coco::stray patchbay::impl::handle(pw::port port)
+    coco::stray patchbay::impl::receive(cr_recipe::sender, vencord::unlink)
     {
-        const auto id = port.id();
-        auto info     = port.info();
-        auto props    = info.props;
+        const auto scope = span{"receive<unlink>"};
 
-        auto raw_parent = props["node.id"];
-        auto parent     = std::uint32_t{};
-
-        logger::get()(trace, "[patchbay] (handle) new port: {}", id);
-        logger::get()(trace, "[patchbay] (handle) └ parent: {}", raw_parent);
-
-        if (std::from_chars(raw_parent.data(), raw_parent.data() + raw_parent.size(), parent).ec != std::errc{})
-        {
-            co_return logger::get()(trace, "[patchbay] (handle) could not parse parent of {} (\"{}\")", id, raw_parent);
-        }
+        co_return cleanup(clean::with_mic);
+    }
 
-        ports[id]       = std::move(info);
-        const auto node = nodes.find(parent);
+    template <>
+    coco::stray patchbay::impl::receive(cr_recipe::sender, vencord::unmute)
+    {
+        const auto scope = span{"receive<unmute>"};
 
-        if (node == nodes.end())
+        if (!virt_mic.has_value())
         {
             co_return;
         }
 
-        if (virt_mic.has_value() && should_link(node->second))
+        if (virt_mic->mixer)
         {
-            link(node->second, virt_mic->loopback_receiver.info());
+            co_return virt_mic->mixer->mute(false);
         }
 
-        co_await redirect(node->second);
+        co_await mute(virt_mic->loopback_receiver.id(), false);
     }
 
     template <>
-    coco::stray patchbay::impl::handle(pw::link link)
+    coco::stray patchbay::impl::receive(cr_recipe::sender, vencord::start_capture req)
     {
-        const auto id = link.id();
-        auto info     = link.info();
-        auto props    = info.props;
-
-        logger::get()(trace, "[patchbay] (handle) new link: {}", id);
-        logger::get()(trace, "[patchbay] (handle) ├ from: {} (port: {})", info.output.node, info.output.port);
-        logger::get()(trace, "[patchbay] (handle) └ to: {} (port: {})", info.input.node, info.input.port);
+        const auto scope = span{"receive<start_capture>"};
 
-        const auto from = info.output.node;
-        const auto to   = info.input.node;
-
-        links[id] = std::move(info);
+        ++captures;
+        captured = {};
+        capturer.reset();
 
         if (!virt_mic.has_value())
         {
-            co_return;
+            co_return logger::get()(warn, "[patchbay] (receive) virt-mic not available, nothing to capture");
         }
 
-        if (virt_links.contains(from) || virt_links.contains(to))
-        {
-            co_return;
-        }
+        co_await create_capture(std::clamp(req.seconds, 1u, max_capture));
+    }
 
-        if (const auto it = nodes.find(from); it != nodes.end() && should_link(it->second))
-        {
-            this->link(it->second, virt_mic->loopback_receiver.info());
-        }
+    template <>
+    coco::stray patchbay::impl::receive(cr_recipe::sender, vencord::stop_capture)
+    {
+        const auto scope = span{"receive<stop_capture>"};
 
-        if (const auto it = nodes.find(to); it != nodes.end() && should_link(it->second))
-        {
-            this->link(it->second, virt_mic->loopback_receiver.info());
-        }
+        ++captures;
+        captured = {};
+        capturer.reset();
 
-        logger::get()(debug, "[patchbay] (handle) refreshed nodes ({} -> {}) attached to {}", from, to, id);
+        co_return logger::get()(debug, "[patchbay] (receive) stopped capturing");
     }
 
-    struct pw_metadata_name // NOLINT(*-internal-linkage)
-    {
-        std::string name;
-    };
-
     template <>
-    coco::stray patchbay::impl::handle(pw::metadata metadata)
+    coco::stray patchbay::impl::receive(cr_recipe::sender sender, vencord::measure)
     {
-        auto info  = metadata.properties();
-        auto props = metadata.props();
-
-        const auto id   = metadata.id();
-        const auto name = props["metadata.name"];
+        const auto scope = span{"receive<measure>"};
 
-        logger::get()(debug, "[patchbay] (handle) new metadata: {}", id);
-        logger::get()(debug, "[patchbay] (handle) └ name: {}", name);
+        auto rtn = std::vector<latency>{};
 
-        if (name != "default")
+        if (!virt_mic.has_value())
         {
-            co_return;
+            co_return sender.send(rtn);
         }
 
-        auto *const raw = metadata.get();
-        meta.emplace(std::move(metadata), raw);
-
-        const auto update = [this](const char *raw, pw::metadata_property prop)
+        const auto ports_with = [this](std::uint32_t id, pw::port_direction direction)
         {
-            if (!raw)
+            const auto matching = [direction](const auto &port)
             {
-                return 0;
-            }
+                return port.direction == direction;
+            };
 
-            const auto key = std::string_view{raw};
+            return ports_of(id)                                                       //
+                   | std::views::values                                               //
+                   | std::views::filter(matching)                                     //
+                   | std::views::transform([](const auto &port) { return port.id; }) //
+                   | std::ranges::to<std::vector>();
+        };
 
-            if (key != "default.audio.sink")
+        const auto feeding = [&](const auto &item)
+        {
+            const auto &[id, entry] = item;
+
+            if (!entry.module.has_value())
             {
-                return 0;
+                return std::make_pair(id, entry.route.ports | std::views::keys | std::ranges::to<std::vector>());
             }
 
-            const auto parsed = glz::read_json<pw_metadata_name>(prop.value);
+            const auto playback = std::format("venmic-loopback-playback-{}-{}", id, entry.target);
+            const auto &found   = index.find("node.name", playback);
 
-            if (!parsed.has_value())
+            if (found.empty())
             {
-                logger::get()(warn, "[patchbay] (meta) failed to parse speaker");
-                return 0;
+                return std::make_pair(id, std::vector<std::uint32_t>{});
             }
 
-            const auto node = std::ranges::find_if(nodes,
-                                                   [&](const auto &info)
-                                                   {
-                                                       auto props = info.second.props;
-                                                       return props["node.name"] == parsed->name;
-                                                   });
-
-            default_speaker = speaker{
-                .name = parsed->name,
-            };
+            return std::make_pair(id, ports_with(*found.begin(), pw::port_direction::output));
+        };
 
-            if (node != nodes.end())
-            {
-                default_speaker->id = node->first;
-            }
+        // The links may change while we wait for the server, so we collect the ports up front
+        const auto feeds   = virt_links | std::views::transform(feeding) | std::ranges::to<std::vector>();
+        const auto inputs  = co_await upstream(ports_with(virt_mic->loopback_receiver.id(), pw::port_direction::input));
+        const auto outputs = co_await upstream(ports_with(virt_mic->chromium_source.id(), pw::port_direction::output));
 
-            logger::get()("[patchbay] (meta) found default speaker: {}", parsed->name);
-            logger::get()("[patchbay] (meta) └ node: {}", node == nodes.end() ? "<pending>" : std::to_string(node->first));
+        // Latency added by the sharing setup itself, from its inputs to the outputs chromium reads from
+        auto own = spa_latency_info{.direction = SPA_DIRECTION_INPUT};
 
-            return 0;
-        };
+        if (inputs.has_value() && outputs.has_value())
+        {
+            own.min_quantum = std::max(outputs->min_quantum - inputs->min_quantum, 0.0f);
+            own.max_quantum = std::max(outputs->max_quantum - inputs->max_quantum, 0.0f);
+            own.min_rate    = std::max<std::int32_t>(outputs->min_rate - inputs->min_rate, 0);
+            own.max_rate    = std::max<std::int32_t>(outputs->max_rate - inputs->max_rate, 0);
+            own.min_ns      = std::max<std::int64_t>(outputs->min_ns - inputs->min_ns, 0);
+            own.max_ns      = std::max<std::int64_t>(outputs->max_ns - inputs->max_ns, 0);
+        }
 
-        meta->listener.on<pw::metadata_event::property>(update);
-        update("default.audio.sink", info["default.audio.sink"]);
+        const auto forced  = parse(clock["clock.force-quantum"]);
+        const auto quantum = forced > 0 ? forced : parse(clock["clock.quantum"]);
+        const auto rate    = parse(clock["clock.rate"]);
 
-        co_return co_await redirect();
-    }
+        const auto nanoseconds = [rate](double samples)
+        {
+            return static_cast<std::uint64_t>(samples * 1e9 / (rate > 0 ? rate : 48000));
+        };
 
-    void patchbay::impl::add_global(pw::global global)
-    {
-        const auto forward = []<typename T>(auto self, auto global, std::type_identity<T>) -> coco::stray
+        for (const auto &[id, ports] : feeds)
         {
-            auto bound = co_await self->registry->template bind<T>(global.id);
+            const auto feed = co_await upstream(ports);
 
-            if (bound.has_value())
+            if (!feed.has_value())
             {
-                self->handle(std::move(*bound));
-                co_return;
+                logger::get()(debug, "[patchbay] (measure) no latency reported for {}", id);
+                continue;
             }
 
-            logger::get()(warn, "[patchbay] (add_global) failed to bind {}: {}", global.id, bound.error().message);
-        };
+            auto &item = rtn.emplace_back(latency{
+                .node    = id,
+                .quantum = {feed->min_quantum + own.min_quantum, feed->max_quantum + own.max_quantum},
+                .rate    = {static_cast<std::uint32_t>(feed->min_rate + own.min_rate),
+                            static_cast<std::uint32_t>(feed->max_rate + own.max_rate)},
+                .ns      = {static_cast<std::uint64_t>(feed->min_ns + own.min_ns),
+                            static_cast<std::uint64_t>(feed->max_ns + own.max_ns)},
+            });
 
-        logger::get()(trace, "[patchbay] (add_global) new global {}: {}", global.id, global.type);
+            const auto samples = (item.quantum[1] * (quantum > 0 ? quantum : 1024)) + item.rate[1];
+            item.total         = nanoseconds(samples) + item.ns[1];
 
-        if (global.type == pw::node::type)
-        {
-            forward(this, std::move(global), std::type_identity<pw::node>{});
-        }
-        else if (global.type == pw::port::type)
-        {
-            forward(this, std::move(global), std::type_identity<pw::port>{});
-        }
-        else if (global.type == pw::link::type)
-        {
-            forward(this, std::move(global), std::type_identity<pw::link>{});
-        }
-        else if (global.type == pw::metadata::type)
-        {
-            forward(this, std::move(global), std::type_identity<pw::metadata>{});
+            logger::get()(debug, "[patchbay] (measure) {} -> {}: {} ns", id, virt_mic->chromium_source.id(), item.total);
         }
-    }
-
-    void patchbay::impl::del_global(std::uint32_t id)
-    {
-        virt_links.erase(id);
-
-        nodes.erase(id);
-        ports.erase(id);
-        links.erase(id);
 
-        logger::get()(trace, "[patchbay] (del_global) removed global {}", id);
+        sender.send(rtn);
     }
 
     template <>
-    coco::stray patchbay::impl::receive(cr_recipe::sender, vencord::link_options opts)
+    coco::stray patchbay::impl::receive(cr_recipe::sender sender, vencord::telemetry)
     {
-        if (!virt_mic.has_value())
-        {
-            co_await create_mic(opts.mute);
-        }
+        const auto scope = span{"receive<telemetry>"};
 
-        cleanup(clean::without_mic);
-        options.emplace(std::move(opts));
+        const auto cold = !profiling && profiler_id.has_value();
 
-        co_await core->sync();
+        if (cold)
+        {
+            profiling = profiler::bind(registry->get(), *profiler_id);
 
-        const auto targets = nodes                                                           //
-                             | std::views::values                                            //
-                             | std::views::filter(std::bind_front(&impl::should_link, this)) //
-                             | std::ranges::to<std::vector>();
+            for (const auto &[id, node] : nodes)
+            {
+                if (profiling && owned(node.props))
+                {
+                    profiling->track(id, std::string{node.props["node.name"]});
+                }
+            }
+        }
 
-        for (const auto &node : targets)
+        if (!profiling)
         {
-            link(node, virt_mic->loopback_receiver.info());
+            logger::get()(debug, "[patchbay] (receive) profiler not available");
+            co_return sender.send(std::vector<load>{});
         }
 
-        co_await redirect();
-    }
-
-    template <>
-    coco::stray patchbay::impl::receive(cr_recipe::sender, vencord::unlink)
-    {
-        co_return cleanup(clean::with_mic);
-    }
+        arm(loop->get(), profile_timer, profile_idle, false);
 
-    template <>
-    coco::stray patchbay::impl::receive(cr_recipe::sender, vencord::unmute)
-    {
-        if (!virt_mic.has_value())
+        // A freshly bound profiler has not seen a cycle yet, so the first request is answered once it had time to
+        if (cold)
         {
+            warming.emplace(std::move(sender));
+            arm(loop->get(), warm_timer, profile_warm, false);
             co_return;
         }
 
-        co_await mute(virt_mic->loopback_receiver.info(), false);
+        co_return sender.send(profiling->stats());
     }
 
     template <>
     coco::stray patchbay::impl::receive(cr_recipe::sender, quit)
     {
+        const auto scope = span{"receive<quit>"};
+
         default_speaker.reset();
         cleanup(clean::with_mic);
 
@@ -727,17 +2137,21 @@ namespace vencord
     template <>
     coco::stray patchbay::impl::receive(cr_recipe::sender sender, vencord::list req)
     {
+        const auto scope = span{"receive<list>"};
+
         using clock = std::chrono::system_clock;
 
+        const auto start = std::chrono::steady_clock::now();
+
         const auto desireable = [&req](const auto &item)
         {
-            auto other = item.second.props;
+            const auto &other = item.second.props;
             return std::ranges::all_of(req.props, [&](const auto &key) { return !other[key].empty(); });
         };
 
         const auto can_output = [](const auto &item)
         {
-            return item.second.output.max > 0;
+            return item.second.can_output;
         };
 
         logger::get()(debug, "[patchbay] (receive) listing nodes ({})", req.props);
@@ -745,19 +2159,20 @@ namespace vencord
         for (const auto start = clock::now(); clock::now() - start < 500ms && nodes.empty();)
         {
             logger::get()(debug, "[patchbay] (receive) no nodes available, syncing...");
-            co_await core->sync();
+            co_await sync();
         }
 
         const auto filtered = nodes                                    //
                               | std::ranges::views::filter(desireable) //
                               | std::ranges::views::filter(can_output) //
+                              | std::ranges::views::keys               //
                               | std::ranges::to<std::vector>();
 
         logger::get()(debug, "[patchbay] (receive) found {} nodes", filtered.size());
 
         auto rtn = std::vector<node>{};
 
-        for (const auto &[id, info] : filtered)
+        for (const auto &id : filtered)
         {
             const auto bound = co_await registry->bind<pw::node>(id);
 
@@ -767,9 +2182,15 @@ namespace vencord
                 continue;
             }
 
-            rtn.emplace_back(bound->info().props);
+            auto &props = rtn.emplace_back(bound->info().props);
+
+            if (auto link = virt_links.find(id); link != virt_links.end() && !link->second.conversion.empty())
+            {
+                props["venmic.conversion"] = link->second.conversion;
+            }
         }
 
+        stats.list.observe(std::chrono::steady_clock::now() - start);
         sender.send(rtn);
     }
 
@@ -823,7 +2244,12 @@ namespace vencord
         const auto callback = [this, &sender]<typename T>(T message)
         {
             logger::get()(trace, "[patchbay] received message {}", glz::type_name<T>);
-            logger::get()(trace, "[patchbay] └ with content: {}", glz::write_json(message).value_or(""));
+
+            if (logger::get().enabled(trace))
+            {
+                logger::get()(trace, "[patchbay] └ with content: {}", glz::write_json(message).value_or(""));
+            }
+
             receive(sender, std::move(message));
         };
         receiver.attach(loop, callback);
@@ -833,9 +2259,55 @@ namespace vencord
         listener.on<pw::registry_event::global>(std::bind_front(&impl::add_global, this));
         listener.on<pw::registry_event::global_removed>(std::bind_front(&impl::del_global, this));
 
+        const auto on_timer = [](void *data, std::uint64_t)
+        {
+            static_cast<impl *>(data)->update_gates();
+        };
+
+        const auto on_deadline = [](void *data, std::uint64_t)
+        {
+            auto *const self = static_cast<impl *>(data);
+
+            if (!self->flushing)
+            {
+                return;
+            }
+
+            self->stats.deadlines.fetch_add(1, std::memory_order_relaxed);
+            self->evaluate();
+        };
+
+        const auto on_idle = [](void *data, std::uint64_t)
+        {
+            static_cast<impl *>(data)->release_profiler();
+        };
+
+        const auto on_warm = [](void *data, std::uint64_t)
+        {
+            auto *const self = static_cast<impl *>(data);
+
+            if (!self->warming.has_value())
+            {
+                return;
+            }
+
+            auto sender = std::exchange(self->warming, std::nullopt);
+            sender->send(self->profiling ? self->profiling->stats() : std::vector<load>{});
+        };
+
+        gate_timer    = pw_loop_add_timer(pw_main_loop_get_loop(loop->get()), on_timer, this);
+        flush_timer   = pw_loop_add_timer(pw_main_loop_get_loop(loop->get()), on_deadline, this);
+        profile_timer = pw_loop_add_timer(pw_main_loop_get_loop(loop->get()), on_idle, this);
+        warm_timer    = pw_loop_add_timer(pw_main_loop_get_loop(loop->get()), on_warm, this);
+
         sender.send(ready{true});
         loop->run();
 
+        pw_loop_destroy_source(pw_main_loop_get_loop(loop->get()), std::exchange(gate_timer, nullptr));
+        pw_loop_destroy_source(pw_main_loop_get_loop(loop->get()), std::exchange(flush_timer, nullptr));
+        pw_loop_destroy_source(pw_main_loop_get_loop(loop->get()), std::exchange(profile_timer, nullptr));
+        pw_loop_destroy_source(pw_main_loop_get_loop(loop->get()), std::exchange(warm_timer, nullptr));
+
         sender.send(quit{});
     }
 } // namespace vencord
@@ -0,0 +1,305 @@
+#include "profiler.hpp"
+#include "logger.hpp"
+
+#include <span>
+#include <array>
+#include <ranges>
+#include <numeric>
+#include <optional>
+#include <algorithm>
+#include <unordered_map>
+
+#include <pipewire/core.h>
+#include <pipewire/proxy.h>
+#include <pipewire/extensions/profiler.h>
+
+#include <spa/pod/iter.h>
+#include <spa/pod/parser.h>
+
+namespace vencord
+{
+    using enum logger::level;
+
+    static constexpr auto window   = 256uz; // Cycles kept per node, about five seconds at a quantum of 1024
+    static constexpr auto finished = 3;     // PW_NODE_ACTIVATION_FINISHED, which is not part of the public headers
+
+    struct block // NOLINT(*-internal-linkage)
+    {
+        std::int32_t id;
+        const char *name;
+
+      public:
+        std::int64_t signal;
+        std::int64_t awake;
+        std::int64_t finish;
+        std::int32_t status;
+
+      public:
+        std::optional<std::int32_t> xruns; // Only reported by recent servers
+    };
+
+    struct profiler::impl
+    {
+        struct stats
+        {
+            std::string name;
+            std::uint64_t xruns{0};
+            std::optional<std::int32_t> counter; // Last xrun counter reported by the server
+
+          public:
+            std::size_t cycles{0};
+            std::array<float, window> busy{};
+            std::array<float, window> wait{};
+        };
+
+      public:
+        pw_profiler *profiler{nullptr};
+        spa_hook listener{};
+
+      public:
+        std::unordered_map<std::uint32_t, stats> nodes;
+
+      public:
+        ~impl();
+
+      public:
+        void profile(const spa_pod *);
+        void record(const block &, double period);
+    };
+
+    profiler::impl::~impl()
+    {
+        if (!profiler)
+        {
+            return;
+        }
+
+        spa_hook_remove(&listener);
+        pw_proxy_destroy(reinterpret_cast<pw_proxy *>(profiler));
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static std::optional<double> period_of(const spa_pod *pod)
+    {
+        auto parser = spa_pod_parser{};
+        auto frame  = spa_pod_frame{};
+
+        auto flags    = std::int32_t{};
+        auto id       = std::int32_t{};
+        auto nsec     = std::int64_t{};
+        auto rate     = spa_fraction{};
+        auto position = std::int64_t{};
+        auto duration = std::int64_t{};
+
+        const char *name{};
+
+        spa_pod_parser_pod(&parser, pod);
+
+        if (spa_pod_parser_push_struct(&parser, &frame) < 0)
+        {
+            return std::nullopt;
+        }
+
+        if (spa_pod_parser_get(&parser,                 //
+                               SPA_POD_Int(&flags),     //
+                               SPA_POD_Int(&id),        //
+                               SPA_POD_String(&name),   //
+                               SPA_POD_Long(&nsec),     //
+                               SPA_POD_Fraction(&rate), //
+                               SPA_POD_Long(&position), //
+                               SPA_POD_Long(&duration), //
+                               nullptr) < 0)
+        {
+            return std::nullopt;
+        }
+
+        if (rate.denom == 0)
+        {
+            return std::nullopt;
+        }
+
+        return static_cast<double>(duration) * 1e9 * rate.num / rate.denom;
+    }
+
+    // NOLINTNEXTLINE(*-anonymous-namespace)
+    static std::optional<block> block_of(const spa_pod *pod)
+    {
+        auto parser = spa_pod_parser{};
+        auto frame  = spa_pod_frame{};
+
+        auto rtn         = block{};
+        auto prev_signal = std::int64_t{};
+        auto latency     = spa_fraction{};
+
+        spa_pod_parser_pod(&parser, pod);
+
+        if (spa_pod_parser_push_struct(&parser, &frame) < 0)
+        {
+            return std::nullopt;
+        }
+
+        if (spa_pod_parser_get(&parser,                    //
+                               SPA_POD_Int(&rtn.id),       //
+                               SPA_POD_String(&rtn.name),  //
+                               SPA_POD_Long(&prev_signal), //
+                               SPA_POD_Long(&rtn.signal),  //
+                               SPA_POD_Long(&rtn.awake),   //
+                               SPA_POD_Long(&rtn.finish),  //
+                               SPA_POD_Int(&rtn.status),   //
+                               SPA_POD_Fraction(&latency), //
+                               nullptr) < 0)
+        {
+            return std::nullopt;
+        }
+
+        if (auto xruns = std::int32_t{}; spa_pod_parser_get(&parser, SPA_POD_Int(&xruns), nullptr) >= 0)
+        {
+            rtn.xruns = xruns;
+        }
+
+        return rtn;
+    }
+
+    void profiler::impl::profile(const spa_pod *pod)
+    {
+        const spa_pod *item{};
+
+        SPA_POD_STRUCT_FOREACH(pod, item)
+        {
+            if (!spa_pod_is_object_type(item, SPA_TYPE_OBJECT_Profiler))
+            {
+                continue;
+            }
+
+            auto period = std::optional<double>{};
+            const spa_pod_prop *prop{};
+
+            // The clock of the driver is reported before the blocks of the nodes it drives
+            SPA_POD_OBJECT_FOREACH(reinterpret_cast<const spa_pod_object *>(item), prop)
+            {
+                if (prop->key == SPA_PROFILER_clock)
+                {
+                    period = period_of(&prop->value);
+                    continue;
+                }
+
+                if (prop->key != SPA_PROFILER_driverBlock && prop->key != SPA_PROFILER_followerBlock)
+                {
+                    continue;
+                }
+
+                if (const auto parsed = block_of(&prop->value); parsed.has_value() && period.value_or(0) > 0)
+                {
+                    record(*parsed, *period);
+                }
+            }
+        }
+    }
+
+    void profiler::impl::record(const block &item, double period)
+    {
+        const auto it = nodes.find(static_cast<std::uint32_t>(item.id));
+
+        if (it == nodes.end())
+        {
+            return;
+        }
+
+        auto &entry      = it->second;
+        const auto index = entry.cycles++ % window;
+
+        entry.busy[index] = item.finish > item.awake ? static_cast<float>((item.finish - item.awake) / period) : 0.0f;
+        entry.wait[index] = item.awake > item.signal ? static_cast<float>((item.awake - item.signal) / period) : 0.0f;
+
+        if (!item.xruns.has_value())
+        {
+            // Older servers don't count xruns per node, a node that did not finish its cycle is the closest we get
+            entry.xruns += item.status != finished;
+            return;
+        }
+
+        if (entry.counter.has_value() && *item.xruns > *entry.counter)
+        {
+            entry.xruns += *item.xruns - *entry.counter;
+
+            logger::get()(debug, "[profiler] (record) {} ({}) had {} xrun(s)", item.id, entry.name,
+                          *item.xruns - *entry.counter);
+        }
+
+        entry.counter = item.xruns;
+    }
+
+    profiler::profiler() : m_impl(std::make_unique<impl>()) {}
+
+    profiler::~profiler() = default;
+
+    void profiler::track(std::uint32_t id, std::string name)
+    {
+        m_impl->nodes.try_emplace(id, impl::stats{.name = std::move(name)});
+        logger::get()(trace, "[profiler] (track) tracking {}", id);
+    }
+
+    void profiler::untrack(std::uint32_t id)
+    {
+        m_impl->nodes.erase(id);
+    }
+
+    std::vector<load> profiler::stats() const
+    {
+        const auto convert = [](const auto &item)
+        {
+            const auto &[id, entry] = item;
+            const auto cycles       = std::min(entry.cycles, window);
+
+            const auto busy = std::span{entry.busy}.first(cycles);
+            const auto wait = std::span{entry.wait}.first(cycles);
+
+            const auto average = [cycles](auto values)
+            {
+                return cycles > 0 ? std::accumulate(values.begin(), values.end(), 0.0f) / static_cast<float>(cycles) : 0.0f;
+            };
+
+            return load{
+                .node   = id,
+                .name   = entry.name,
+                .xruns  = entry.xruns,
+                .cycles = static_cast<std::uint32_t>(cycles),
+                .busy   = average(busy),
+                .wait   = average(wait),
+                .peak   = cycles > 0 ? std::ranges::max(busy) : 0.0f,
+            };
+        };
+
+        return m_impl->nodes | std::views::transform(convert) | std::ranges::to<std::vector>();
+    }
+
+    std::unique_ptr<profiler> profiler::bind(pw_registry *registry, std::uint32_t id)
+    {
+        static constexpr auto events = pw_profiler_events{
+            .version = PW_VERSION_PROFILER_EVENTS,
+            .profile =
+                [](void *data, const spa_pod *pod)
+            {
+                static_cast<impl *>(data)->profile(pod);
+            },
+        };
+
+        auto *const bound = static_cast<pw_profiler *>(
+            pw_registry_bind(registry, id, PW_TYPE_INTERFACE_Profiler, PW_VERSION_PROFILER, 0));
+
+        if (!bound)
+        {
+            logger::get()(error, "[profiler] (bind) failed to bind profiler {}", id);
+            return nullptr;
+        }
+
+        auto rtn = std::unique_ptr<profiler>(new profiler);
+
+        rtn->m_impl->profiler = bound;
+        pw_profiler_add_listener(bound, &rtn->m_impl->listener, &events, rtn->m_impl.get());
+
+        logger::get()("[profiler] (bind) listening to profiler {}", id);
+
+        return rtn;
+    }
+} // namespace vencord
@@ -0,0 +1,70 @@
+#include "properties.hpp"
+
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace vencord
+{
+    properties::properties(const properties &other) : m_strings(other.m_strings), m_entries(other.m_entries)
+    {
+        for (const auto &[key, value] : m_entries)
+        {
+            std::ignore = m_strings->intern(key);
+            std::ignore = m_strings->intern(value);
+        }
+    }
+
+    properties::properties(properties &&other) noexcept
+        : m_strings(std::exchange(other.m_strings, nullptr)), m_entries(std::move(other.m_entries))
+    {
+        other.m_entries.clear();
+    }
+
+    properties &properties::operator=(properties other)
+    {
+        std::swap(m_strings, other.m_strings);
+        std::swap(m_entries, other.m_entries);
+
+        return *this;
+    }
+
+    properties::~properties()
+    {
+        for (const auto &[key, value] : m_entries)
+        {
+            m_strings->release(key);
+            m_strings->release(value);
+        }
+    }
+
+    bool properties::contains(std::string_view key) const
+    {
+        return std::ranges::binary_search(m_entries, key, {}, &entry::first);
+    }
+
+    std::string_view properties::at(std::string_view key) const
+    {
+        const auto it = std::ranges::lower_bound(m_entries, key, {}, &entry::first);
+
+        if (it == m_entries.end() || it->first != key)
+        {
+            throw std::out_of_range{"properties::at"};
+        }
+
+        return it->second;
+    }
+
+    std::string_view properties::operator[](std::string_view key) const
+    {
+        const auto it = std::ranges::lower_bound(m_entries, key, {}, &entry::first);
+
+        if (it == m_entries.end() || it->first != key)
+        {
+            return {};
+        }
+
+        return it->second;
+    }
+} // namespace vencord
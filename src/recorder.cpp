@@ -0,0 +1,184 @@
+#include "recorder.hpp"
+#include "logger.hpp"
+
+#include <new>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace vencord
+{
+    namespace fs = std::filesystem;
+    using enum logger::level;
+
+    struct recorder::impl
+    {
+        void *memory{nullptr};
+        std::size_t size{0};
+
+      public:
+        header *head{nullptr};
+        record *records{nullptr};
+
+      public:
+        ~impl();
+    };
+
+    recorder::impl::~impl()
+    {
+        if (!memory)
+        {
+            return;
+        }
+
+        ::munmap(memory, size);
+    }
+
+    recorder::recorder() : m_impl(std::make_unique<impl>())
+    {
+        const auto file = path();
+        auto ec         = std::error_code{};
+
+        fs::create_directories(file.parent_path(), ec);
+
+        // Keep the events of the previous run around, they are usually the ones leading up to a reported glitch
+        if (fs::exists(file, ec))
+        {
+            fs::rename(file, fs::path{file} += ".old", ec);
+        }
+
+        const auto size = sizeof(header) + (capacity * sizeof(record));
+        const auto fd   = ::open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644); // NOLINT(*-vararg)
+
+        if (fd < 0)
+        {
+            logger::get()(warn, "[recorder] (init) failed to open {}: {}", file.string(), std::strerror(errno));
+            return;
+        }
+
+        // The file is zero-filled, so every slot starts out with an invalid sequence
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            logger::get()(warn, "[recorder] (init) failed to resize {}: {}", file.string(), std::strerror(errno));
+            ::close(fd);
+            return;
+        }
+
+        auto *const memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (memory == MAP_FAILED)
+        {
+            logger::get()(warn, "[recorder] (init) failed to map {}: {}", file.string(), std::strerror(errno));
+            return;
+        }
+
+        m_impl->memory = memory;
+        m_impl->size   = size;
+
+        m_impl->head = new (memory) header{
+            .magic    = magic,
+            .version  = version,
+            .capacity = capacity,
+            .head     = 0,
+        };
+
+        m_impl->records = reinterpret_cast<record *>(static_cast<char *>(memory) + sizeof(header));
+
+        logger::get()(debug, "[recorder] (init) recording events into {}", file.string());
+    }
+
+    void recorder::write(event id, std::array<std::uint32_t, 6> args, std::uint16_t count) const
+    {
+        if (!m_impl->head)
+        {
+            return;
+        }
+
+        const auto index = std::atomic_ref{m_impl->head->head}.fetch_add(1, std::memory_order_relaxed);
+        const auto now   = std::chrono::system_clock::now().time_since_epoch();
+
+        auto &slot    = m_impl->records[index % capacity];
+        auto sequence = std::atomic_ref{slot.sequence};
+
+        // Invalidate the slot first, so that a torn record is never mistaken for a complete one
+        sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+        slot.id        = id;
+        slot.count     = count;
+        slot.args      = args;
+
+        sequence.store(static_cast<std::uint32_t>(index + 1), std::memory_order_release);
+    }
+
+    recorder &recorder::get()
+    {
+        static std::unique_ptr<recorder> instance;
+
+        if (!instance)
+        {
+            instance = std::unique_ptr<recorder>(new recorder);
+        }
+
+        return *instance;
+    }
+
+    fs::path recorder::path()
+    {
+        return logger::directory() / "venmic.events";
+    }
+
+    std::string_view recorder::describe(event id)
+    {
+        switch (id)
+        {
+            using enum event;
+
+        case node_added:
+            return "[patchbay] (handle) new node: {}";
+        case port_added:
+            return "[patchbay] (handle) new port: {} (parent: {})";
+        case link_added:
+            return "[patchbay] (handle) new link: {} (from: {} (port: {}), to: {} (port: {}))";
+        case metadata_added:
+            return "[patchbay] (handle) new metadata: {}";
+        case global_removed:
+            return "[patchbay] (del_global) removed global {}";
+        case link_accepted:
+            return "[patchbay] (should_link) accepted {}";
+        case link_rejected:
+            return "[patchbay] (should_link) rejected {}";
+        case mixed:
+            return "[patchbay] (link) mixing {} into {}";
+        case routed:
+            return "[patchbay] (link) routing {} -> {} directly ({} port(s))";
+        case loopback_created:
+            return "[patchbay] (link) created loopback {} -> {} ({} created so far)";
+        case loopback_failed:
+            return "[patchbay] (link) failed to create loopback ({} -> {})";
+        case redirected:
+            return "[patchbay] (redirect) redirected {}";
+        case muted:
+            return "[patchbay] (mute) {} (muted: {})";
+        case quantum_forced:
+            return "[patchbay] (force_quantum) forced quantum: {}";
+        case flushed:
+            return "[patchbay] (flush) evaluated {} node(s)";
+        case relinked:
+            return "[patchbay] (receive) relinked with {} target(s), removed {} stale loopback(s)";
+        case gated:
+            return "[patchbay] (gate) {} is silent, paused capturing it";
+        case ungated:
+            return "[patchbay] (gate) {} is audible again, resumed capturing it";
+        }
+
+        return "unknown event";
+    }
+} // namespace vencord
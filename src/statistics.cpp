@@ -0,0 +1,151 @@
+#include "statistics.hpp"
+
+#include <format>
+#include <utility>
+#include <iterator>
+
+namespace vencord
+{
+    static constexpr auto event_names = std::array{"node", "port", "link", "metadata", "removed"};
+
+    tally::tally(std::atomic<std::uint64_t> *gauge, std::atomic<std::uint64_t> *released)
+        : m_gauge(gauge), m_released(released), m_held(true)
+    {
+        if (m_gauge)
+        {
+            m_gauge->fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    tally::tally(tally &&other) noexcept
+        : m_gauge(std::exchange(other.m_gauge, nullptr)), m_released(std::exchange(other.m_released, nullptr)),
+          m_held(std::exchange(other.m_held, false))
+    {
+    }
+
+    tally &tally::operator=(tally &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+
+            m_gauge    = std::exchange(other.m_gauge, nullptr);
+            m_released = std::exchange(other.m_released, nullptr);
+            m_held     = std::exchange(other.m_held, false);
+        }
+
+        return *this;
+    }
+
+    tally::~tally()
+    {
+        release();
+    }
+
+    tally::operator bool() const
+    {
+        return m_held;
+    }
+
+    void tally::release()
+    {
+        if (!std::exchange(m_held, false))
+        {
+            return;
+        }
+
+        if (m_gauge)
+        {
+            m_gauge->fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        if (m_released)
+        {
+            m_released->fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void histogram::observe(std::chrono::nanoseconds value)
+    {
+        const auto seconds = std::chrono::duration<double>{value}.count();
+        auto bucket        = 0uz;
+
+        while (bounds.size() > bucket && seconds > bounds[bucket])
+        {
+            ++bucket;
+        }
+
+        m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value.count(), std::memory_order_relaxed);
+    }
+
+    void histogram::render(std::string &out, std::string_view name, std::string_view help) const
+    {
+        auto it         = std::back_inserter(out);
+        auto cumulative = std::uint64_t{0};
+
+        std::format_to(it, "# HELP {} {}\n", name, help);
+        std::format_to(it, "# TYPE {} histogram\n", name);
+
+        for (auto bucket = 0uz; bounds.size() > bucket; ++bucket)
+        {
+            cumulative += m_buckets[bucket].load(std::memory_order_relaxed);
+            std::format_to(it, "{}_bucket{{le=\"{}\"}} {}\n", name, bounds[bucket], cumulative);
+        }
+
+        cumulative += m_buckets.back().load(std::memory_order_relaxed);
+
+        std::format_to(it, "{}_bucket{{le=\"+Inf\"}} {}\n", name, cumulative);
+        std::format_to(it, "{}_sum {}\n", name, static_cast<double>(m_sum.load(std::memory_order_relaxed)) / 1e9);
+        std::format_to(it, "{}_count {}\n", name, cumulative);
+    }
+
+    void statistics::count(event type)
+    {
+        events[static_cast<std::size_t>(type)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::string statistics::render() const
+    {
+        auto rtn = std::string{};
+        auto it  = std::back_inserter(rtn);
+
+        const auto metric = [&](std::string_view name, std::string_view type, std::string_view help, const auto &value)
+        {
+            std::format_to(it, "# HELP {} {}\n", name, help);
+            std::format_to(it, "# TYPE {} {}\n", name, type);
+            std::format_to(it, "{} {}\n", name, value.load(std::memory_order_relaxed));
+        };
+
+        metric("venmic_nodes", "gauge", "Nodes known to venmic", nodes);
+        metric("venmic_ports", "gauge", "Ports known to venmic", ports);
+        metric("venmic_links", "gauge", "Links known to venmic", links);
+        metric("venmic_virt_links", "gauge", "Nodes currently linked to the virtual microphone", virt_links);
+        metric("venmic_active_sources", "gauge", "Linked nodes that are currently captured", active);
+        metric("venmic_gated_sources", "gauge", "Linked nodes that are not captured because they are silent", gated);
+
+        std::format_to(it, "# HELP venmic_events_total Registry events processed, by type\n");
+        std::format_to(it, "# TYPE venmic_events_total counter\n");
+
+        for (auto type = 0uz; event_names.size() > type; ++type)
+        {
+            std::format_to(it, "venmic_events_total{{type=\"{}\"}} {}\n", event_names[type],
+                           events[type].load(std::memory_order_relaxed));
+        }
+
+        metric("venmic_loopbacks_created_total", "counter", "Loopback modules loaded", loopbacks_created);
+        metric("venmic_loopbacks_destroyed_total", "counter", "Loopback modules unloaded", loopbacks_destroyed);
+        metric("venmic_batch_scheduled_total", "counter", "Node evaluations requested by registry events", scheduled);
+        metric("venmic_batch_evaluated_total", "counter", "Node evaluations performed after coalescing", evaluated);
+        metric("venmic_batch_dropped_total", "counter", "Scheduled nodes removed before their batch ran", dropped);
+        metric("venmic_batch_deadlines_total", "counter", "Batches evaluated before their sync completed", deadlines);
+        metric("venmic_should_link_evaluations_total", "counter", "Link decisions that were not cached", evaluations);
+        metric("venmic_should_link_acceptances_total", "counter", "Link decisions that accepted the node", acceptances);
+
+        should_link.render(rtn, "venmic_should_link_seconds", "Time spent deciding whether to link a node");
+        list.render(rtn, "venmic_list_seconds", "Time spent answering list requests");
+        sync.render(rtn, "venmic_sync_seconds", "Round-trip time of pipewire core syncs");
+
+        return rtn;
+    }
+} // namespace vencord
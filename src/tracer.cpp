@@ -0,0 +1,143 @@
+#include "tracer.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <iterator>
+#include <algorithm>
+
+namespace vencord
+{
+    static constexpr auto capacity = 4096uz; // Spans kept per thread, older ones are overwritten
+
+    struct tracer::ring
+    {
+        // Every slot is guarded by a sequence counter, which is odd while the owning thread writes to it
+        struct slot
+        {
+            std::atomic<std::uint32_t> sequence{0};
+
+          public:
+            std::atomic<const char *> name{nullptr};
+            std::atomic<std::uint64_t> start{0};
+            std::atomic<std::uint64_t> duration{0};
+        };
+
+      public:
+        std::size_t thread;
+        std::size_t head{0}; // Only accessed by the owning thread
+        std::array<slot, capacity> slots;
+    };
+
+    struct event // NOLINT(*-internal-linkage)
+    {
+        const char *name;
+        std::uint64_t start;
+        std::uint64_t duration;
+        std::size_t thread;
+    };
+
+    void tracer::record(const char *name, std::uint64_t start, std::uint64_t end)
+    {
+        thread_local const auto local = [this]
+        {
+            auto rtn = std::make_shared<ring>();
+
+            auto lock   = std::lock_guard{m_mutex};
+            rtn->thread = m_rings.size() + 1;
+
+            m_rings.emplace_back(rtn);
+
+            return rtn;
+        }();
+
+        auto &slot     = local->slots[local->head++ % capacity];
+        const auto seq = slot.sequence.load(std::memory_order_relaxed);
+
+        slot.sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.duration.store(end - start, std::memory_order_relaxed);
+
+        slot.sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    std::string tracer::dump()
+    {
+        auto rings = std::vector<std::shared_ptr<ring>>{};
+        {
+            auto lock = std::lock_guard{m_mutex};
+            rings     = m_rings;
+        }
+
+        auto events = std::vector<event>{};
+
+        for (const auto &ring : rings)
+        {
+            for (const auto &slot : ring->slots)
+            {
+                const auto before = slot.sequence.load(std::memory_order_acquire);
+
+                auto item = event{
+                    .name     = slot.name.load(std::memory_order_relaxed),
+                    .start    = slot.start.load(std::memory_order_relaxed),
+                    .duration = slot.duration.load(std::memory_order_relaxed),
+                    .thread   = ring->thread,
+                };
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                // Skip slots that were never written, or that were overwritten while we read them
+                if (before == 0 || before % 2 != 0 || slot.sequence.load(std::memory_order_relaxed) != before)
+                {
+                    continue;
+                }
+
+                events.emplace_back(item);
+            }
+        }
+
+        std::ranges::sort(events, {}, &event::start);
+
+        auto rtn = std::string{R"({"displayTimeUnit":"ns","traceEvents":[)"};
+        auto it  = std::back_inserter(rtn);
+
+        for (const auto &item : events)
+        {
+            if (&item != &events.front())
+            {
+                rtn += ',';
+            }
+
+            std::format_to(it, R"({{"name":"{}","cat":"venmic","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{}}})",
+                           item.name, static_cast<double>(item.start) / 1e3, static_cast<double>(item.duration) / 1e3,
+                           item.thread);
+        }
+
+        rtn += "]}";
+
+        return rtn;
+    }
+
+    std::uint64_t tracer::now()
+    {
+        const auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+    tracer &tracer::get()
+    {
+        static auto instance = tracer{};
+        return instance;
+    }
+
+    span::span(const char *name) : name(name), start(tracer::now()) {}
+
+    span::~span()
+    {
+        tracer::get().record(name, start, tracer::now());
+    }
+} // namespace vencord
@@ -1,6 +1,38 @@
 const venmic = require("../../lib");
 const assert = require("assert");
 
+const matches = (value, props) => venmic.PatchBay.matches([{ "node.name": value }], props);
+const firefox = { "node.name": "Firefox", "application.name": "Firefox" };
+
+assert(matches("Firefox", firefox));
+assert(!matches("Fire", firefox));
+assert(!matches("Firefox", {}));
+
+assert(matches("prefix:Fire", firefox));
+assert(!matches("prefix:fox", firefox));
+
+assert(matches("glob:Fire*", firefox));
+assert(matches("glob:*fox", firefox));
+assert(matches("glob:F?ref*x", firefox));
+assert(matches("glob:Firefox", firefox));
+assert(!matches("glob:fox*", firefox));
+assert(!matches("glob:Fire", firefox));
+assert(!matches("glob:Firefox?", firefox));
+
+assert(matches("regex:Fire(fox|bird)", firefox));
+assert(!matches("regex:fox", firefox));
+assert(!matches("regex:Fire", firefox));
+assert(!matches("regex:(", firefox));
+
+assert(matches("exact:prefix:Fire", { "node.name": "prefix:Fire" }));
+assert(!matches("exact:prefix:Fire", firefox));
+
+assert(venmic.PatchBay.matches([{ "node.name": "regex:(" }, { "application.name": "glob:Fire*" }], firefox));
+assert(!venmic.PatchBay.matches([{ "node.name": "Firefox", "application.name": "prefix:Chrom" }], firefox));
+
+assert.throws(() => venmic.PatchBay.matches({}, firefox), /expected list of rules/ig);
+assert.throws(() => venmic.PatchBay.matches([{ "node.name": 10 }], firefox), /expected list of rules/ig);
+
 let patchbay = null;
 
 try
@@ -37,7 +69,41 @@ assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "Firefox" }]
 
 assert.doesNotThrow(() => patchbay.link({ include: [{ "node.name": "Firefox" }], exclude: [{ "object.id": "100" }] }));
 
+assert.doesNotThrow(() => patchbay.link({ include: [{ "application.process.binary": "glob:chrom*" }] }));
+assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "prefix:Firefox" }, { "node.name": "regex:(" }] }));
+
 assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "Firefox" }], ignore_devices: true }));
 assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "Firefox" }], ignore_devices: true, only_default_speakers: true }));
+assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "Firefox" }], direct: true }));
+assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "Firefox" }], meter: true }));
+assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "Firefox" }], duplex: true }));
+assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "Firefox" }], positions: [], rate: 0 }));
+assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "Firefox" }], latency: 256, force_quantum: true }));
+assert.doesNotThrow(() => patchbay.link({ exclude: [{ "node.name": "Firefox" }], gate: 5000 }));
+
+assert(Array.isArray(patchbay.levels()));
+assert(Array.isArray(patchbay.measure()));
+assert(Array.isArray(patchbay.telemetry()));
+
+assert.throws(() => patchbay.startCapture("30"), /expected amount of seconds/ig);
+assert.doesNotThrow(() => patchbay.startCapture(5));
+assert.doesNotThrow(() => patchbay.stopCapture());
+
+(async () =>
+{
+    assert(Array.isArray(await patchbay.listAsync(["node.name"])));
+    await assert.rejects(patchbay.listAsync({}), /expected list of strings/ig);
+
+    await assert.rejects(patchbay.linkAsync(10), /expected link object/ig);
+    await assert.rejects(patchbay.linkAsync({ include: "Firefox" }), /key-value/ig);
+    assert.strictEqual(await patchbay.linkAsync({ exclude: [{ "node.name": "Firefox" }] }), true);
 
-assert.doesNotThrow(() => patchbay.unlink());
+    assert(Array.isArray(await patchbay.measureAsync()));
+    assert(Array.isArray(await patchbay.telemetryAsync()));
+
+    assert.doesNotThrow(() => patchbay.unlink());
+})().catch(error =>
+{
+    console.error(error);
+    process.exit(1);
+});